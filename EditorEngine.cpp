@@ -1,6 +1,8 @@
 #include "EditorEngine.h"
 #include "Objects/Settings.h"
 #include "Objects/SystemVariableManager.h"
+#include "Objects/Tracer.h"
+#include "Objects/StartupProfiler.h"
 
 namespace ed
 {
@@ -8,14 +10,12 @@ namespace ed
 		m_ui(&m_interface, wnd, gl),
 		m_interface(&m_ui)
 	{
-		m_interface.Plugins.Init(&m_interface, &m_ui); // load plugins (TODO: maybe move this to the splash screen)
+		m_interface.Plugins.Init(&m_interface, &m_ui); // plugins are loaded after the first frame or when a project is opened
+		m_startupFrames = 0;
 	}
 	void EditorEngine::Create()
 	{
 		m_ui.LoadSettings();
-
-		// load template
-		m_interface.Pipeline.New();
 	}
 	void EditorEngine::OnEvent(const SDL_Event& e)
 	{
@@ -24,6 +24,12 @@ namespace ed
 	}
 	void EditorEngine::Update(float delta)
 	{
+		TRACE_ZONE("EditorEngine::Update");
+
+		// the first frame has already been presented
+		if (m_startupFrames < 2 && ++m_startupFrames == 2)
+			m_finishStartup();
+
 		// first update system time delta value
 		SystemVariableManager::Instance().SetTimeDelta(delta);
 
@@ -32,8 +38,26 @@ namespace ed
 	}
 	void EditorEngine::Render()
 	{
+		TRACE_ZONE("EditorEngine::Render");
 		m_ui.Render();
 	}
+	void EditorEngine::m_finishStartup()
+	{
+		StartupProfiler& startup = StartupProfiler::Instance();
+
+		startup.Begin("Loading plugins");
+		m_interface.Plugins.Load();
+		startup.End();
+
+		// load template if no project was opened through the arguments
+		if (m_interface.Parser.GetOpenedFile().empty() && m_interface.Pipeline.GetList().size() == 0) {
+			startup.Begin("Loading the template");
+			m_interface.Pipeline.New();
+			startup.End();
+		}
+
+		startup.Finish();
+	}
 	void EditorEngine::Destroy()
 	{
 		m_interface.Pipeline.Clear();
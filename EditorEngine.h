@@ -26,5 +26,8 @@ namespace ed
 	private:
 		InterfaceManager m_interface;
 		GUIManager m_ui;
+
+		void m_finishStartup();
+		int m_startupFrames; // plugins and the template are loaded after the first frame has been presented
 	};
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "GLCallCounter.h"
+#include <string.h>
+
+namespace ed
+{
+	namespace gl
+	{
+		static const char* TYPE_NAMES[] = {
+			"Draw calls",
+			"Dispatches",
+			"Program binds",
+			"Texture binds",
+			"Buffer binds",
+			"Uniform uploads",
+			"Skipped uniform uploads",
+			"Uniform lookups",
+			"Buffer uploads",
+			"Texture uploads",
+			"Framebuffer binds",
+			"State changes",
+			"Sync points"
+		};
+		static const char* TYPE_KEYS[] = {
+			"draws",
+			"dispatches",
+			"program_binds",
+			"texture_binds",
+			"buffer_binds",
+			"uniform_uploads",
+			"uniform_skips",
+			"uniform_lookups",
+			"buffer_uploads",
+			"texture_uploads",
+			"framebuffer_binds",
+			"state_changes",
+			"sync_points"
+		};
+
+		CallCounter::CallCounter()
+		{
+			m_enabled = false;
+			Reset();
+		}
+		void CallCounter::EndFrame()
+		{
+			memcpy(m_last, m_current, sizeof(m_last));
+			memset(m_current, 0, sizeof(m_current));
+		}
+		void CallCounter::Reset()
+		{
+			memset(m_current, 0, sizeof(m_current));
+			memset(m_last, 0, sizeof(m_last));
+		}
+		const char* CallCounter::GetName(Type type)
+		{
+			return TYPE_NAMES[(int)type];
+		}
+		const char* CallCounter::GetKey(Type type)
+		{
+			return TYPE_KEYS[(int)type];
+		}
+	}
+}
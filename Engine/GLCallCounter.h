@@ -0,0 +1,59 @@
+#pragma once
+
+namespace ed
+{
+	namespace gl
+	{
+		// number of GL calls of each kind made in a frame - the calls are counted in the files that include GLCallCounterHooks.h
+		class CallCounter
+		{
+		public:
+			enum class Type
+			{
+				Draw,
+				Dispatch,
+				ProgramBind,
+				TextureBind,
+				BufferBind,
+				UniformUpload,
+				UniformSkip,	// upload skipped because the value didn't change
+				UniformLookup,	// glGetUniformLocation
+				BufferUpload,
+				TextureUpload,
+				FramebufferBind,
+				StateChange,
+				SyncPoint,		// glGetTexImage, glGetBufferSubData
+				Count
+			};
+
+			static inline CallCounter& Instance()
+			{
+				static CallCounter ret;
+				return ret;
+			}
+
+			// off by default - turned on by the Preview.GLCallCounters setting or the --gl-calls option
+			inline void SetEnabled(bool enabled) { m_enabled = enabled; }
+			inline bool IsEnabled() const { return m_enabled; }
+
+			inline void Add(Type type) { if (m_enabled) m_current[(int)type]++; }
+
+			// called after the pipeline has been rendered
+			void EndFrame();
+			void Reset();
+
+			// counters of the last finished frame
+			inline unsigned int Get(Type type) const { return m_last[(int)type]; }
+
+			static const char* GetName(Type type);	// "Draw calls"
+			static const char* GetKey(Type type);	// "draws"
+
+		private:
+			CallCounter();
+
+			bool m_enabled;
+			unsigned int m_current[(int)Type::Count];
+			unsigned int m_last[(int)Type::Count];
+		};
+	}
+}
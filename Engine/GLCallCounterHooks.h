@@ -0,0 +1,334 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#if defined(__APPLE__)
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+#include "GLCallCounter.h"
+
+// Redirects the GL entry points to wrappers that update gl::CallCounter.
+// Include this file after all the other headers and only in .cpp files.
+
+namespace ed
+{
+	namespace gl
+	{
+		namespace hook
+		{
+			inline void DrawArrays(GLenum mode, GLint first, GLsizei count)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::Draw);
+				glDrawArrays(mode, first, count);
+			}
+			inline void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::Draw);
+				glDrawArraysInstanced(mode, first, count, instances);
+			}
+			inline void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::Draw);
+				glDrawElements(mode, count, type, indices);
+			}
+			inline void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::Draw);
+				glDrawElementsInstanced(mode, count, type, indices, instances);
+			}
+			inline void DispatchCompute(GLuint x, GLuint y, GLuint z)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::Dispatch);
+				glDispatchCompute(x, y, z);
+			}
+			inline void UseProgram(GLuint program)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::ProgramBind);
+				glUseProgram(program);
+			}
+			inline void BindTexture(GLenum target, GLuint texture)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::TextureBind);
+				glBindTexture(target, texture);
+			}
+			inline void BindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::TextureBind);
+				glBindImageTexture(unit, texture, level, layered, layer, access, format);
+			}
+			inline void BindBuffer(GLenum target, GLuint buffer)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::BufferBind);
+				glBindBuffer(target, buffer);
+			}
+			inline void BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::BufferBind);
+				glBindBufferBase(target, index, buffer);
+			}
+			inline void BindVertexArray(GLuint vao)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::BufferBind);
+				glBindVertexArray(vao);
+			}
+			inline void Uniform1i(GLint loc, GLint x)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform1i(loc, x);
+			}
+			inline void Uniform1f(GLint loc, GLfloat x)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform1f(loc, x);
+			}
+			inline void Uniform3f(GLint loc, GLfloat x, GLfloat y, GLfloat z)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform3f(loc, x, y, z);
+			}
+			inline void Uniform2iv(GLint loc, GLsizei count, const GLint* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform2iv(loc, count, value);
+			}
+			inline void Uniform3iv(GLint loc, GLsizei count, const GLint* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform3iv(loc, count, value);
+			}
+			inline void Uniform4iv(GLint loc, GLsizei count, const GLint* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform4iv(loc, count, value);
+			}
+			inline void Uniform2fv(GLint loc, GLsizei count, const GLfloat* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform2fv(loc, count, value);
+			}
+			inline void Uniform3fv(GLint loc, GLsizei count, const GLfloat* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform3fv(loc, count, value);
+			}
+			inline void Uniform4fv(GLint loc, GLsizei count, const GLfloat* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniform4fv(loc, count, value);
+			}
+			inline void UniformMatrix2fv(GLint loc, GLsizei count, GLboolean transpose, const GLfloat* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniformMatrix2fv(loc, count, transpose, value);
+			}
+			inline void UniformMatrix3fv(GLint loc, GLsizei count, GLboolean transpose, const GLfloat* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniformMatrix3fv(loc, count, transpose, value);
+			}
+			inline void UniformMatrix4fv(GLint loc, GLsizei count, GLboolean transpose, const GLfloat* value)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformUpload);
+				glUniformMatrix4fv(loc, count, transpose, value);
+			}
+			inline GLint GetUniformLocation(GLuint program, const GLchar* name)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::UniformLookup);
+				return glGetUniformLocation(program, name);
+			}
+			inline void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::BufferUpload);
+				glBufferData(target, size, data, usage);
+			}
+			inline void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::BufferUpload);
+				glBufferSubData(target, offset, size, data);
+			}
+			inline void TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::TextureUpload);
+				glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+			}
+			inline void TexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::TextureUpload);
+				glTexImage3D(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+			}
+			inline void BindFramebuffer(GLenum target, GLuint fbo)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::FramebufferBind);
+				glBindFramebuffer(target, fbo);
+			}
+			inline void Enable(GLenum cap)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glEnable(cap);
+			}
+			inline void Disable(GLenum cap)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glDisable(cap);
+			}
+			inline void DepthFunc(GLenum func)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glDepthFunc(func);
+			}
+			inline void DepthMask(GLboolean flag)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glDepthMask(flag);
+			}
+			inline void CullFace(GLenum mode)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glCullFace(mode);
+			}
+			inline void FrontFace(GLenum mode)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glFrontFace(mode);
+			}
+			inline void PolygonMode(GLenum face, GLenum mode)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glPolygonMode(face, mode);
+			}
+			inline void BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+			}
+			inline void BlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glBlendEquationSeparate(modeRGB, modeAlpha);
+			}
+			inline void BlendColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glBlendColor(r, g, b, a);
+			}
+			inline void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glStencilFuncSeparate(face, func, ref, mask);
+			}
+			inline void StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glStencilOpSeparate(face, sfail, dpfail, dppass);
+			}
+			inline void StencilMask(GLuint mask)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::StateChange);
+				glStencilMask(mask);
+			}
+			inline void GetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void* pixels)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::SyncPoint);
+				glGetTexImage(target, level, format, type, pixels);
+			}
+			inline void GetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void* data)
+			{
+				CallCounter::Instance().Add(CallCounter::Type::SyncPoint);
+				glGetBufferSubData(target, offset, size, data);
+			}
+		}
+	}
+}
+
+#undef glDrawArrays
+#undef glDrawArraysInstanced
+#undef glDrawElements
+#undef glDrawElementsInstanced
+#undef glDispatchCompute
+#undef glUseProgram
+#undef glBindTexture
+#undef glBindImageTexture
+#undef glBindBuffer
+#undef glBindBufferBase
+#undef glBindVertexArray
+#undef glUniform1i
+#undef glUniform1f
+#undef glUniform3f
+#undef glUniform2iv
+#undef glUniform3iv
+#undef glUniform4iv
+#undef glUniform2fv
+#undef glUniform3fv
+#undef glUniform4fv
+#undef glUniformMatrix2fv
+#undef glUniformMatrix3fv
+#undef glUniformMatrix4fv
+#undef glGetUniformLocation
+#undef glBufferData
+#undef glBufferSubData
+#undef glTexImage2D
+#undef glTexImage3D
+#undef glBindFramebuffer
+#undef glEnable
+#undef glDisable
+#undef glDepthFunc
+#undef glDepthMask
+#undef glCullFace
+#undef glFrontFace
+#undef glPolygonMode
+#undef glBlendFuncSeparate
+#undef glBlendEquationSeparate
+#undef glBlendColor
+#undef glStencilFuncSeparate
+#undef glStencilOpSeparate
+#undef glStencilMask
+#undef glGetTexImage
+#undef glGetBufferSubData
+
+#define glDrawArrays ed::gl::hook::DrawArrays
+#define glDrawArraysInstanced ed::gl::hook::DrawArraysInstanced
+#define glDrawElements ed::gl::hook::DrawElements
+#define glDrawElementsInstanced ed::gl::hook::DrawElementsInstanced
+#define glDispatchCompute ed::gl::hook::DispatchCompute
+#define glUseProgram ed::gl::hook::UseProgram
+#define glBindTexture ed::gl::hook::BindTexture
+#define glBindImageTexture ed::gl::hook::BindImageTexture
+#define glBindBuffer ed::gl::hook::BindBuffer
+#define glBindBufferBase ed::gl::hook::BindBufferBase
+#define glBindVertexArray ed::gl::hook::BindVertexArray
+#define glUniform1i ed::gl::hook::Uniform1i
+#define glUniform1f ed::gl::hook::Uniform1f
+#define glUniform3f ed::gl::hook::Uniform3f
+#define glUniform2iv ed::gl::hook::Uniform2iv
+#define glUniform3iv ed::gl::hook::Uniform3iv
+#define glUniform4iv ed::gl::hook::Uniform4iv
+#define glUniform2fv ed::gl::hook::Uniform2fv
+#define glUniform3fv ed::gl::hook::Uniform3fv
+#define glUniform4fv ed::gl::hook::Uniform4fv
+#define glUniformMatrix2fv ed::gl::hook::UniformMatrix2fv
+#define glUniformMatrix3fv ed::gl::hook::UniformMatrix3fv
+#define glUniformMatrix4fv ed::gl::hook::UniformMatrix4fv
+#define glGetUniformLocation ed::gl::hook::GetUniformLocation
+#define glBufferData ed::gl::hook::BufferData
+#define glBufferSubData ed::gl::hook::BufferSubData
+#define glTexImage2D ed::gl::hook::TexImage2D
+#define glTexImage3D ed::gl::hook::TexImage3D
+#define glBindFramebuffer ed::gl::hook::BindFramebuffer
+#define glEnable ed::gl::hook::Enable
+#define glDisable ed::gl::hook::Disable
+#define glDepthFunc ed::gl::hook::DepthFunc
+#define glDepthMask ed::gl::hook::DepthMask
+#define glCullFace ed::gl::hook::CullFace
+#define glFrontFace ed::gl::hook::FrontFace
+#define glPolygonMode ed::gl::hook::PolygonMode
+#define glBlendFuncSeparate ed::gl::hook::BlendFuncSeparate
+#define glBlendEquationSeparate ed::gl::hook::BlendEquationSeparate
+#define glBlendColor ed::gl::hook::BlendColor
+#define glStencilFuncSeparate ed::gl::hook::StencilFuncSeparate
+#define glStencilOpSeparate ed::gl::hook::StencilOpSeparate
+#define glStencilMask ed::gl::hook::StencilMask
+#define glGetTexImage ed::gl::hook::GetTexImage
+#define glGetBufferSubData ed::gl::hook::GetBufferSubData
@@ -13,6 +13,8 @@
 
 #include <iostream>
 
+#include "GLCallCounterHooks.h"
+
 namespace ed
 {
 	namespace eng
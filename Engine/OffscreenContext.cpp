@@ -0,0 +1,204 @@
+#include "OffscreenContext.h"
+#include "../Objects/Logger.h"
+
+#include <SDL2/SDL.h>
+#include <string.h>
+#include <string>
+
+#ifdef SHADERED_USE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace ed
+{
+	namespace eng
+	{
+		OffscreenContext::OffscreenContext()
+		{
+			m_created = false;
+			m_eglDisplay = nullptr;
+			m_eglContext = nullptr;
+			m_eglSurface = nullptr;
+			m_wnd = nullptr;
+			m_sdlContext = nullptr;
+		}
+		OffscreenContext::~OffscreenContext()
+		{
+			Destroy();
+		}
+		bool OffscreenContext::Create(int major, int minor)
+		{
+			if (m_created)
+				return true;
+
+			m_created = m_createEGL(major, minor);
+			if (!m_created)
+				m_created = m_createSDL(major, minor);
+
+			return m_created;
+		}
+		void OffscreenContext::Destroy()
+		{
+#ifdef SHADERED_USE_EGL
+			if (m_eglDisplay != nullptr) {
+				eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+				if (m_eglSurface != nullptr)
+					eglDestroySurface(m_eglDisplay, m_eglSurface);
+				if (m_eglContext != nullptr)
+					eglDestroyContext(m_eglDisplay, m_eglContext);
+				eglTerminate(m_eglDisplay);
+			}
+#endif
+			m_eglDisplay = m_eglContext = m_eglSurface = nullptr;
+
+			if (m_sdlContext != nullptr)
+				SDL_GL_DeleteContext(m_sdlContext);
+			if (m_wnd != nullptr) {
+				SDL_DestroyWindow(m_wnd);
+				SDL_QuitSubSystem(SDL_INIT_VIDEO);
+			}
+			m_sdlContext = nullptr;
+			m_wnd = nullptr;
+
+			m_created = false;
+		}
+		bool OffscreenContext::MakeCurrent()
+		{
+#ifdef SHADERED_USE_EGL
+			if (m_eglDisplay != nullptr) {
+				EGLSurface surface = m_eglSurface == nullptr ? EGL_NO_SURFACE : m_eglSurface;
+				return eglMakeCurrent(m_eglDisplay, surface, surface, m_eglContext) == EGL_TRUE;
+			}
+#endif
+			if (m_wnd != nullptr)
+				return SDL_GL_MakeCurrent(m_wnd, m_sdlContext) == 0;
+
+			return false;
+		}
+		bool OffscreenContext::m_createEGL(int major, int minor)
+		{
+#ifdef SHADERED_USE_EGL
+			// prefer the surfaceless platform so that no X11/Wayland server is needed
+			EGLDisplay display = EGL_NO_DISPLAY;
+			const char* clientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+			if (clientExts != nullptr && strstr(clientExts, "EGL_MESA_platform_surfaceless") != nullptr) {
+				PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+				if (getPlatformDisplay != nullptr)
+					display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+			}
+			if (display == EGL_NO_DISPLAY)
+				display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+			EGLint verMajor = 0, verMinor = 0;
+			if (display == EGL_NO_DISPLAY || eglInitialize(display, &verMajor, &verMinor) != EGL_TRUE) {
+				Logger::Get().Log("Failed to initialize EGL display", true);
+				return false;
+			}
+			Logger::Get().Log("Initialized EGL " + std::to_string(verMajor) + "." + std::to_string(verMinor));
+
+			// pick a config - the surfaceless platform might not expose pbuffer configs
+			EGLint cfgAttribs[] = {
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_RED_SIZE, 8,
+				EGL_GREEN_SIZE, 8,
+				EGL_BLUE_SIZE, 8,
+				EGL_ALPHA_SIZE, 8,
+				EGL_DEPTH_SIZE, 24,
+				EGL_STENCIL_SIZE, 8,
+				EGL_NONE
+			};
+			EGLConfig config = nullptr;
+			EGLint configCount = 0;
+			bool hasPbuffer = eglChooseConfig(display, cfgAttribs, &config, 1, &configCount) == EGL_TRUE && configCount > 0;
+			if (!hasPbuffer) {
+				cfgAttribs[1] = 0;
+				if (eglChooseConfig(display, cfgAttribs, &config, 1, &configCount) != EGL_TRUE || configCount <= 0) {
+					Logger::Get().Log("Failed to find a suitable EGL config", true);
+					eglTerminate(display);
+					return false;
+				}
+			}
+
+			if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE) {
+				Logger::Get().Log("EGL implementation doesn't support desktop OpenGL", true);
+				eglTerminate(display);
+				return false;
+			}
+
+			EGLint ctxAttribs[] = {
+				EGL_CONTEXT_MAJOR_VERSION, major,
+				EGL_CONTEXT_MINOR_VERSION, minor,
+				EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+				EGL_NONE
+			};
+			EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, ctxAttribs);
+			if (context == EGL_NO_CONTEXT) {
+				Logger::Get().Log("Failed to create an OpenGL " + std::to_string(major) + "." + std::to_string(minor) + " EGL context", true);
+				eglTerminate(display);
+				return false;
+			}
+
+			// all the rendering is done to FBOs so we don't need a surface - use a tiny pbuffer if the driver insists on one
+			EGLSurface surface = EGL_NO_SURFACE;
+			if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) != EGL_TRUE) {
+				EGLint pbAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+				if (hasPbuffer)
+					surface = eglCreatePbufferSurface(display, config, pbAttribs);
+
+				if (surface == EGL_NO_SURFACE || eglMakeCurrent(display, surface, surface, context) != EGL_TRUE) {
+					Logger::Get().Log("Failed to make the EGL context current", true);
+					if (surface != EGL_NO_SURFACE)
+						eglDestroySurface(display, surface);
+					eglDestroyContext(display, context);
+					eglTerminate(display);
+					return false;
+				}
+			}
+
+			m_eglDisplay = display;
+			m_eglContext = context;
+			m_eglSurface = surface == EGL_NO_SURFACE ? nullptr : surface;
+
+			Logger::Get().Log("Created an offscreen EGL context");
+
+			return true;
+#else
+			return false;
+#endif
+		}
+		bool OffscreenContext::m_createSDL(int major, int minor)
+		{
+			if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
+				Logger::Get().Log("Failed to initialize SDL2 video subsystem", true);
+				return false;
+			}
+
+			SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+			SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, major);
+			SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, minor);
+
+			m_wnd = SDL_CreateWindow("SHADERed", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1, 1, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+			if (m_wnd == nullptr) {
+				Logger::Get().Log("Failed to create a hidden SDL2 window", true);
+				SDL_QuitSubSystem(SDL_INIT_VIDEO);
+				return false;
+			}
+
+			m_sdlContext = SDL_GL_CreateContext(m_wnd);
+			if (m_sdlContext == nullptr) {
+				Logger::Get().Log("Failed to create an OpenGL context for the hidden window", true);
+				SDL_DestroyWindow(m_wnd);
+				SDL_QuitSubSystem(SDL_INIT_VIDEO);
+				m_wnd = nullptr;
+				return false;
+			}
+			SDL_GL_MakeCurrent(m_wnd, m_sdlContext);
+
+			Logger::Get().Log("Created an offscreen context using a hidden SDL2 window");
+
+			return true;
+		}
+	}
+}
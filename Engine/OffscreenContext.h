@@ -0,0 +1,37 @@
+#pragma once
+#include <SDL2/SDL_video.h>
+
+namespace ed
+{
+	namespace eng
+	{
+		// OpenGL context that isn't attached to any visible window - used by the command line modes
+		// uses a surfaceless EGL context when SHADERED_USE_EGL is defined, otherwise a hidden SDL window
+		class OffscreenContext
+		{
+		public:
+			OffscreenContext();
+			~OffscreenContext();
+
+			bool Create(int major = 3, int minor = 3);
+			void Destroy();
+
+			bool MakeCurrent();
+
+			inline bool IsCreated() { return m_created; }
+			inline bool IsEGL() { return m_eglDisplay != nullptr; }
+
+		private:
+			bool m_created;
+
+			bool m_createEGL(int major, int minor);
+			void* m_eglDisplay;
+			void* m_eglContext;
+			void* m_eglSurface;
+
+			bool m_createSDL(int major, int minor);
+			SDL_Window* m_wnd;
+			SDL_GLContext m_sdlContext;
+		};
+	}
+}
@@ -10,6 +10,7 @@
 #include "UI/ObjectListUI.h"
 #include "UI/MessageOutputUI.h"
 #include "UI/PixelInspectUI.h"
+#include "UI/ProfilerUI.h"
 #include "UI/PipelineUI.h"
 #include "UI/PropertyUI.h"
 #include "UI/PreviewUI.h"
@@ -29,8 +30,9 @@
 #include "Objects/CameraSnapshots.h"
 #include "Objects/Export/ExportCPP.h"
 #include "Objects/KeyboardShortcuts.h"
-#include "Objects/FunctionVariableManager.h"
 #include "Objects/SystemVariableManager.h"
+#include "Objects/Tracer.h"
+#include "Objects/StartupProfiler.h"
 
 #include <fstream>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -105,10 +107,15 @@ namespace ed
 		m_expcppSavePath = "./export.cpp";
 		m_expcppError = false;
 
+		StartupProfiler& startup = StartupProfiler::Instance();
+
+		startup.Begin("Loading settings");
 		Settings::Instance().Load();
 		m_loadTemplateList();
+		startup.End();
 		
 		Logger::Get().Log("Initializing Dear ImGUI");
+		startup.Begin("Initializing Dear ImGui");
 		
 		// set vsync on startup
 		SDL_GL_SetSwapInterval(Settings::Instance().General.VSync);
@@ -129,8 +136,10 @@ namespace ed
 		ImGui_ImplSDL2_InitForOpenGL(m_wnd, *m_gl);
 
 		ImGui::StyleColorsDark();
+		startup.End();
 
 		Logger::Get().Log("Creating various UI view objects");
+		startup.Begin("Creating UI views");
 
 		m_views.push_back(new PreviewUI(this, objects, "Preview"));
 		m_views.push_back(new PinnedUI(this, objects, "Pinned"));
@@ -140,6 +149,7 @@ namespace ed
 		m_views.push_back(new PipelineUI(this, objects, "Pipeline"));
 		m_views.push_back(new PropertyUI(this, objects, "Properties"));
 		m_views.push_back(new PixelInspectUI(this, objects, "Pixel Inspect"));
+		m_views.push_back(new ProfilerUI(this, objects, "Profiler", false));
 
 		m_debugViews.push_back(new DebugWatchUI(this, objects, "Watch"));
 		m_debugViews.push_back(new DebugValuesUI(this, objects, "Variables"));
@@ -159,7 +169,7 @@ namespace ed
 		((CodeEditorUI*)Get(ViewID::Code))->SetAutoRecompile(Settings::Instance().General.AutoRecompile);
 
 		((OptionsUI*)m_options)->SetGroup(OptionsUI::Page::General);
-
+		startup.End();
 
 		// get dpi
 		float dpi;
@@ -498,8 +508,10 @@ namespace ed
 		m_performanceMode = m_perfModeFake;
 
 		// update audio textures
-		m_data->Objects.Update(delta);
-		FunctionVariableManager::ClearVariableList();
+		{
+			TRACE_ZONE("ObjectManager::Update");
+			m_data->Objects.Update(delta);
+		}
 
 		// update editor & workspace font
 		if (((CodeEditorUI*)Get(ViewID::Code))->NeedsFontUpdate() ||
@@ -508,7 +520,9 @@ namespace ed
 				strcmp(settings.General.Font, "null") != 0) ||
 			m_fontNeedsUpdate)
 		{
+			TRACE_ZONE("Update fonts");
 			Logger::Get().Log("Updating fonts...");
+			StartupProfiler::Instance().Begin("Building the font atlas");
 
 			std::pair<std::string, int> edFont = ((CodeEditorUI*)Get(ViewID::Code))->GetFont();
 
@@ -525,7 +539,13 @@ namespace ed
   			ImGuiIO& io = ImGui::GetIO();
 			ImFontConfig config;
 			config.MergeMode = true;
-  			static const ImWchar icon_ranges[] = { 0xea5b, 0xf026, 0 };
+			static ImVector<ImWchar> iconRanges; // only the glyphs listed in UI_ICON_ALL
+			if (iconRanges.empty()) {
+				ImFontGlyphRangesBuilder rangesBuilder;
+				rangesBuilder.AddText(UI_ICON_ALL);
+				rangesBuilder.BuildRanges(&iconRanges);
+			}
+			const ImWchar* icon_ranges = iconRanges.Data;
 			io.Fonts->AddFontFromFileTTF("data/icofont.ttf", m_cachedFontSize * Settings::Instance().DPIScale, &config, icon_ranges);
 			
 			ImFont* edFontPtr = fonts->AddFontFromFileTTF(edFont.first.c_str(), edFont.second * Settings::Instance().DPIScale);
@@ -548,6 +568,7 @@ namespace ed
 			ImGui_ImplOpenGL3_DestroyFontsTexture();
 
 			((CodeEditorUI*)Get(ViewID::Code))->UpdateFont();
+			StartupProfiler::Instance().End();
 		}
 
 		// Start the Dear ImGui frame
@@ -760,6 +781,16 @@ namespace ed
 					*m_settingsBkp = settings;
 					m_shortcutsBkp = KeyboardShortcuts::Instance().GetMap();
 				}
+				if (!Tracer::Instance().IsEnabled()) {
+					if (ImGui::MenuItem("Start tracing"))
+						Tracer::Instance().Start();
+				} else if (ImGui::MenuItem("Stop tracing")) {
+					Tracer::Instance().Stop();
+
+					std::string file;
+					if (UIHelper::GetSaveFileDialog(file, "json"))
+						Tracer::Instance().Save(file);
+				}
 
 				m_data->Plugins.ShowMenuItems("project");
 				
@@ -881,6 +912,7 @@ namespace ed
 			for (auto& view : m_views)
 				if (view->Visible) {
 					ImGui::SetNextWindowSizeConstraints(ImVec2(80, 80), ImVec2(m_width*2, m_height*2));
+					TRACE_ZONE(view->Name.c_str());
 					if (ImGui::Begin(view->Name.c_str(), &view->Visible)) view->Update(delta);
 					ImGui::End();
 				}
@@ -897,6 +929,10 @@ namespace ed
 			Get(ViewID::Code)->Update(delta);
 		}
 
+		// only measure the pipeline items while somebody is looking at the results
+		ProfilerUI* profilerUI = (ProfilerUI*)Get(ViewID::Profiler);
+		m_data->Renderer.GetProfiler().SetEnabled(profilerUI->Visible && !profilerUI->IsPaused() && !m_performanceMode);
+
 		// object preview
 		if (((ed::ObjectPreviewUI*)m_objectPrev)->ShouldRun() && !m_performanceMode)
 			m_objectPrev->Update(delta);
@@ -1241,6 +1277,7 @@ namespace ed
 			ImGui::TextWrapped("KeysWASD (vec4) - W, A, S or D keys state");
 			ImGui::TextWrapped("Mouse (vec4) - vec4(x,y,left,right) updated every frame");
 			ImGui::TextWrapped("MouseButton (vec4) - vec4(viewX,viewY,clickX,clickY) updated only when left mouse button is down");
+			ImGui::TextWrapped("PassSlice (ivec4) - ivec4(index,count,firstGroup,groupCount) of the time slice executed in this frame, compute passes add firstGroup to gl_WorkGroupID.x");
 
 			ImGui::NewLine();
 			ImGui::Separator();
@@ -1757,6 +1794,7 @@ namespace ed
 		}
 
 		// render ImGUI
+		TRACE_ZONE("ImGui::Render");
 		ImGui::Render();
 	}
 	void GUIManager::m_renderOptions()
@@ -1840,6 +1878,8 @@ namespace ed
 	}
 	void GUIManager::Render()
 	{
+		TRACE_ZONE("GUIManager::Render");
+
 		// actually render to back buffer
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
@@ -1886,7 +1926,9 @@ namespace ed
 
 		Get(ViewID::Code)->Visible = false;
 
+		StartupProfiler::Instance().Begin("Applying the theme");
 		((OptionsUI*)m_options)->ApplyTheme();
+		StartupProfiler::Instance().End();
 	}
 	void GUIManager::m_imguiHandleEvent(const SDL_Event& e)
 	{
@@ -29,6 +29,7 @@ namespace ed
 		Pipeline,
 		Properties,
 		PixelInspect,
+		Profiler,
 		DebugWatch,
 		DebugValues,
 		DebugFunctionStack,
@@ -0,0 +1,653 @@
+#include "HeadlessEngine.h"
+#include "Objects/SystemVariableManager.h"
+#include "Objects/BatchCompiler.h"
+#include "Objects/MicroBenchmark.h"
+#include "Objects/Settings.h"
+#include "Objects/Logger.h"
+#include "Engine/GLCallCounter.h"
+
+#include <stb/stb_image.h>
+#include <stb/stb_image_write.h>
+#include <ghc/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+
+namespace ed
+{
+	HeadlessEngine::HeadlessEngine()
+	{
+		m_interface = nullptr;
+	}
+	HeadlessEngine::~HeadlessEngine()
+	{
+		Destroy();
+	}
+	bool HeadlessEngine::Create()
+	{
+		if (!m_context.Create(3, 3)) {
+			Logger::Get().Log("Failed to create an offscreen OpenGL context", true);
+			return false;
+		}
+
+		// init glew - GLEW built against GLX can't find a display in EGL-only environments but still loads all the functions
+		glewExperimental = true;
+		GLenum glewRes = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		if (glewRes == GLEW_ERROR_NO_GLX_DISPLAY && m_context.IsEGL())
+			glewRes = GLEW_OK;
+#endif
+		if (glewRes != GLEW_OK) {
+			Logger::Get().Log("Failed to initialize GLEW", true);
+			return false;
+		}
+		Logger::Get().Log("Initialized GLEW");
+
+		glEnable(GL_DEPTH_TEST);
+		glEnable(GL_STENCIL_TEST);
+
+		Settings::Instance().Load();
+
+		// every render texture can be exported, so don't skip the passes that aren't visible in the UI
+		Settings::Instance().Preview.SkipUnusedPasses = false;
+
+		// frames must be measured & compared with every pass actually rendered
+		Settings::Instance().Preview.CachePasses = false;
+		Settings::Instance().Preview.GLCallCounters = false;
+
+		// plugins need an ImGui context so they aren't loaded in the headless mode
+		m_interface = new InterfaceManager(nullptr);
+		m_interface->Renderer.AllowComputeShaders(GLEW_ARB_compute_shader);
+
+		// time is controlled manually
+		auto& sysVM = SystemVariableManager::Instance();
+		sysVM.GetTimeClock().Pause();
+		sysVM.GetTimeClock().Restart();
+
+		return true;
+	}
+	void HeadlessEngine::Destroy()
+	{
+		if (m_interface != nullptr) {
+			m_interface->Pipeline.Clear();
+			delete m_interface;
+			m_interface = nullptr;
+		}
+
+		m_context.Destroy();
+	}
+	bool HeadlessEngine::Open(const std::string& file)
+	{
+		if (!ghc::filesystem::exists(file)) {
+			Logger::Get().Log("Project file " + file + " doesn't exist", true);
+			return false;
+		}
+
+		m_interface->Renderer.FlushCache();
+		m_interface->Parser.Open(file);
+
+		if (m_interface->Pipeline.GetList().size() == 0) {
+			Logger::Get().Log("Project " + file + " has no pipeline items", true);
+			return false;
+		}
+
+		return true;
+	}
+	void HeadlessEngine::Render(int width, int height, float time, float delta, int frameIndex)
+	{
+		auto& sysVM = SystemVariableManager::Instance();
+		sysVM.AdvanceTimer(time - sysVM.GetTime());
+		sysVM.SetTimeDelta(delta);
+		sysVM.SetFrameIndex(frameIndex);
+
+		m_interface->Renderer.Render(width, height);
+	}
+	bool HeadlessEngine::Save(const std::string& outDir, int frame, const std::vector<std::string>& filter)
+	{
+		bool ret = true;
+
+		std::string suffix = "";
+		if (frame >= 0) {
+			char frameStr[16];
+			snprintf(frameStr, 16, "_%04d", frame);
+			suffix = frameStr;
+		}
+
+		auto isSelected = [&](const std::string& name) -> bool {
+			return filter.size() == 0 || std::count(filter.begin(), filter.end(), name) > 0;
+		};
+
+		// window
+		if (isSelected("Window")) {
+			glm::ivec2 size = m_interface->Renderer.GetLastRenderSize();
+			ret &= m_saveTexture(m_interface->Renderer.GetTexture(), size.x, size.y, outDir + "/Window" + suffix + ".png");
+		}
+
+		// render textures
+		ObjectManager& objs = m_interface->Objects;
+		for (const auto& name : objs.GetObjects()) {
+			if (!objs.IsRenderTexture(name) || !isSelected(name))
+				continue;
+
+			glm::ivec2 size = objs.GetRenderTextureSize(name);
+			ret &= m_saveTexture(objs.GetTexture(name), size.x, size.y, outDir + "/" + name + suffix + ".png");
+		}
+
+		return ret;
+	}
+	int HeadlessEngine::Run(const CommandLineOptionParser& options)
+	{
+		Logger::Get().Log("Running in headless mode");
+
+		if (!Create())
+			return 1;
+
+		if (!Open(options.ProjectFile))
+			return 1;
+
+		std::string outDir = options.OutputPath.empty() ? options.WorkingDirectory : options.OutputPath;
+		std::error_code errCode;
+		if (!ghc::filesystem::exists(outDir))
+			ghc::filesystem::create_directories(outDir, errCode);
+
+		float delta = 1.0f / options.FPS;
+		bool ret = true;
+		for (int i = 0; i < options.FrameCount; i++) {
+			Render(options.RenderWidth, options.RenderHeight, options.StartTime + i * delta, delta, options.FrameIndex + i);
+			ret &= Save(outDir, options.FrameCount == 1 ? -1 : i, options.RenderTextures);
+		}
+
+		glFinish();
+
+		return ret ? 0 : 1;
+	}
+	int HeadlessEngine::Benchmark(const CommandLineOptionParser& options)
+	{
+		Logger::Get().Log("Running in benchmark mode");
+
+		if (!Create())
+			return 1;
+
+		// counting the GL calls slows down the rendering a bit
+		Settings::Instance().Preview.GLCallCounters = options.GLCallCounters;
+
+		if (!Open(options.ProjectFile))
+			return 1;
+
+		float delta = 1.0f / options.FPS;
+		PipelineProfiler& profiler = m_interface->Renderer.GetProfiler();
+
+		// compile the shaders, allocate the resources and let the driver settle down
+		for (int i = 0; i < options.WarmupFrames; i++)
+			Render(options.RenderWidth, options.RenderHeight, options.StartTime + i * delta, delta, options.FrameIndex + i);
+		glFinish();
+
+		profiler.SetHistorySize(options.FrameCount);
+		profiler.SetEnabled(true);
+
+		std::vector<float> frameTimes(options.FrameCount);
+		unsigned int glCalls[(int)gl::CallCounter::Type::Count] = { 0 };
+		for (int i = 0; i < options.FrameCount; i++) {
+			int frame = options.WarmupFrames + i;
+
+			auto frameStart = std::chrono::high_resolution_clock::now();
+			Render(options.RenderWidth, options.RenderHeight, options.StartTime + frame * delta, delta, options.FrameIndex + frame);
+			frameTimes[i] = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - frameStart).count();
+
+			for (int j = 0; j < (int)gl::CallCounter::Type::Count; j++)
+				glCalls[j] += gl::CallCounter::Instance().Get((gl::CallCounter::Type)j);
+		}
+
+		profiler.Flush();
+		profiler.SetEnabled(false);
+
+		// build the report
+		const char* renderer = (const char*)glGetString(GL_RENDERER);
+		const char* version = (const char*)glGetString(GL_VERSION);
+
+		std::stringstream report;
+		report << "{" << std::endl;
+		report << "\t\"project\": \"" << m_jsonEscape(options.ProjectFile) << "\"," << std::endl;
+		report << "\t\"renderer\": \"" << m_jsonEscape(renderer == nullptr ? "" : renderer) << "\"," << std::endl;
+		report << "\t\"version\": \"" << m_jsonEscape(version == nullptr ? "" : version) << "\"," << std::endl;
+		report << "\t\"width\": " << options.RenderWidth << "," << std::endl;
+		report << "\t\"height\": " << options.RenderHeight << "," << std::endl;
+		report << "\t\"warmup\": " << options.WarmupFrames << "," << std::endl;
+		report << "\t\"frames\": " << options.FrameCount << "," << std::endl;
+		report << "\t\"frame\": { \"cpu\": " << m_jsonStats(frameTimes) << " }," << std::endl;
+		if (options.GLCallCounters) {
+			report << "\t\"gl_calls_per_frame\": {";
+			for (int i = 0; i < (int)gl::CallCounter::Type::Count; i++)
+				report << (i == 0 ? " " : ", ") << "\"" << gl::CallCounter::GetKey((gl::CallCounter::Type)i) << "\": " << (float)glCalls[i] / options.FrameCount;
+			report << " }," << std::endl;
+		}
+		report << "\t\"items\": [";
+
+		const std::vector<PipelineItem*>& items = m_interface->Pipeline.GetList();
+		bool first = true;
+		for (PipelineItem* item : items) {
+			const PipelineProfiler::History* hist = profiler.GetHistory(item);
+			if (hist == nullptr)
+				continue;
+
+			// the history is a ring buffer but only the complete set of samples matters here
+			int sampleCount = std::min<int>(hist->Count, hist->Size());
+			std::vector<float> cpu(hist->CPU.begin(), hist->CPU.begin() + sampleCount);
+			std::vector<float> gpu(hist->GPU.begin(), hist->GPU.begin() + sampleCount);
+
+			report << (first ? "" : ",") << std::endl;
+			report << "\t\t{ \"name\": \"" << m_jsonEscape(item->Name) << "\", \"type\": \"" << m_getItemTypeName(item->Type) << "\", ";
+			report << "\"samples\": " << sampleCount << ", ";
+			report << "\"cpu\": " << m_jsonStats(cpu) << ", ";
+			report << "\"gpu\": " << m_jsonStats(gpu) << " }";
+
+			first = false;
+		}
+
+		report << std::endl << "\t]" << std::endl << "}" << std::endl;
+
+		if (options.OutputPath.empty())
+			printf("%s", report.str().c_str());
+		else {
+			std::ofstream reportFile(options.OutputPath);
+			if (!reportFile.is_open()) {
+				Logger::Get().Log("Failed to write the benchmark report to " + options.OutputPath, true);
+				return 1;
+			}
+			reportFile << report.str();
+			reportFile.close();
+		}
+
+		return 0;
+	}
+	int HeadlessEngine::Compile(const CommandLineOptionParser& options)
+	{
+		Logger::Get().Log("Running in compile mode");
+
+		if (!Create())
+			return 1;
+
+		auto compileStart = std::chrono::high_resolution_clock::now();
+
+		BatchCompiler compiler;
+		compiler.SetComputeSupported(GLEW_ARB_compute_shader);
+		compiler.Start(options.ThreadCount);
+
+		// projects have to be opened on this thread, the workers start as soon as a project is queued
+		std::vector<std::string> failedProjects;
+		for (const auto& file : options.ProjectFiles) {
+			if (!Open(file))
+				failedProjects.push_back(file);
+			else
+				compiler.AddProject(file, &m_interface->Pipeline, &m_interface->Parser);
+
+			compiler.Link(false);
+		}
+		compiler.Link(true);
+		compiler.Stop();
+
+		float compileTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - compileStart).count();
+
+		// build the report
+		static const char* stageNames[] = { "VS", "PS", "GS", "CS" };
+		static const char* typeNames[] = { "error", "warning", "message" };
+
+		std::stringstream report;
+		for (const auto& file : failedProjects)
+			report << file << ": error: failed to open the project" << std::endl;
+
+		int failedCount = 0;
+		const std::vector<BatchCompiler::PassResult>& results = compiler.GetResults();
+		for (const auto& result : results) {
+			if (!result.Compiled)
+				failedCount++;
+
+			for (const auto& msg : result.Messages) {
+				report << result.Project << ": " << msg.Group;
+				if (msg.Shader >= 0 && msg.Shader <= 3)
+					report << " (" << stageNames[msg.Shader] << ")";
+				if (msg.Line != -1)
+					report << " line " << msg.Line;
+				report << ": " << typeNames[(int)msg.MType] << ": " << msg.Text << std::endl;
+			}
+		}
+
+		report << "Compiled " << results.size() - failedCount << "/" << results.size() << " passes from " << options.ProjectFiles.size() - failedProjects.size() << "/" << options.ProjectFiles.size();
+		report << " projects in " << std::fixed << std::setprecision(2) << compileTime << "s using " << options.ThreadCount << " threads" << std::endl;
+
+		if (options.OutputPath.empty())
+			printf("%s", report.str().c_str());
+		else {
+			std::ofstream reportFile(options.OutputPath);
+			if (!reportFile.is_open()) {
+				Logger::Get().Log("Failed to write the compile report to " + options.OutputPath, true);
+				return 1;
+			}
+			reportFile << report.str();
+			reportFile.close();
+		}
+
+		return (failedCount == 0 && failedProjects.size() == 0) ? 0 : 1;
+	}
+	int HeadlessEngine::Regression(const CommandLineOptionParser& options)
+	{
+		Logger::Get().Log("Running in regression mode");
+
+		if (!Create())
+			return 1;
+
+		std::string outDir = options.OutputPath.empty() ? options.WorkingDirectory : options.OutputPath;
+		std::error_code errCode;
+		if (!ghc::filesystem::exists(outDir))
+			ghc::filesystem::create_directories(outDir, errCode);
+		if (options.UpdateGolden && !ghc::filesystem::exists(options.GoldenPath))
+			ghc::filesystem::create_directories(options.GoldenPath, errCode);
+
+		// fresh checkouts don't have the golden images
+		if (!options.UpdateGolden && (!ghc::filesystem::exists(options.GoldenPath) || ghc::filesystem::is_empty(options.GoldenPath, errCode))) {
+			printf("FAIL golden directory %s is missing or empty - run the update_golden target (or --update-golden) first\n", options.GoldenPath.c_str());
+			return 1;
+		}
+
+		std::string timingsFile = options.GoldenPath + "/timings.txt";
+		std::map<std::string, float> goldenTimings = m_loadTimings(timingsFile);
+		std::map<std::string, float> newTimings = goldenTimings;
+
+		const int width = options.RenderWidth, height = options.RenderHeight;
+		float delta = 1.0f / options.FPS;
+		int failedCount = 0;
+
+		for (const auto& file : options.ProjectFiles) {
+			std::string key = m_getProjectKey(options.WorkingDirectory, file);
+
+			if (!Open(file)) {
+				printf("FAIL %s: failed to open the project\n", key.c_str());
+				failedCount++;
+				continue;
+			}
+
+			// image - a single frame at the requested time
+			Render(width, height, options.StartTime, delta, options.FrameIndex);
+			std::vector<unsigned char> pixels = m_readTexture(m_interface->Renderer.GetTexture(), width, height);
+
+			// timings - median wall clock time of the frames that follow
+			std::vector<float> frameTimes(options.FrameCount);
+			for (int i = 0; i < options.FrameCount; i++) {
+				auto frameStart = std::chrono::high_resolution_clock::now();
+				Render(width, height, options.StartTime + (i + 1) * delta, delta, options.FrameIndex + i + 1);
+				glFinish();
+				frameTimes[i] = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - frameStart).count();
+			}
+			std::sort(frameTimes.begin(), frameTimes.end());
+			float frameTime = frameTimes[frameTimes.size() / 2];
+
+			std::string goldenImage = options.GoldenPath + "/" + key + ".png";
+
+			if (options.UpdateGolden) {
+				if (stbi_write_png(goldenImage.c_str(), width, height, 4, pixels.data(), width * 4) == 0) {
+					printf("FAIL %s: failed to write %s\n", key.c_str(), goldenImage.c_str());
+					failedCount++;
+					continue;
+				}
+				newTimings[key] = frameTime;
+				printf("UPDATE %s: %.3fms\n", key.c_str(), frameTime);
+				continue;
+			}
+
+			std::string error = "";
+
+			// compare the image
+			int goldenWidth = 0, goldenHeight = 0, goldenComp = 0;
+			unsigned char* golden = stbi_load(goldenImage.c_str(), &goldenWidth, &goldenHeight, &goldenComp, 4);
+			if (golden == nullptr)
+				error = "missing golden image " + goldenImage;
+			else if (goldenWidth != width || goldenHeight != height)
+				error = "golden image size is " + std::to_string(goldenWidth) + "x" + std::to_string(goldenHeight);
+			else {
+				std::vector<unsigned char> diff;
+				int diffCount = m_compareImages(pixels.data(), golden, width, height, options.PixelThreshold, diff);
+				float diffRatio = diffCount / (float)(width * height);
+
+				if (diffRatio > options.MaxDiffRatio) {
+					error = std::to_string(diffCount) + " pixels differ (" + std::to_string(diffRatio * 100.0f) + "%)";
+
+					std::string prefix = outDir + "/" + key;
+					stbi_write_png((prefix + ".png").c_str(), width, height, 4, pixels.data(), width * 4);
+					stbi_write_png((prefix + "_diff.png").c_str(), width, height, 4, diff.data(), width * 4);
+				}
+			}
+			if (golden != nullptr)
+				stbi_image_free(golden);
+
+			// compare the timings - 1ms of slack so that the tiny projects don't fail because of the noise
+			auto goldenTime = goldenTimings.find(key);
+			if (error.empty() && goldenTime != goldenTimings.end()) {
+				float maxTime = goldenTime->second * (1.0f + options.TimeTolerance / 100.0f) + 1.0f;
+				if (frameTime > maxTime) {
+					char timeStr[128];
+					snprintf(timeStr, 128, "frame time %.3fms exceeds %.3fms (golden: %.3fms)", frameTime, maxTime, goldenTime->second);
+					error = timeStr;
+				}
+			}
+
+			if (error.empty())
+				printf("PASS %s: %.3fms\n", key.c_str(), frameTime);
+			else {
+				printf("FAIL %s: %s\n", key.c_str(), error.c_str());
+				failedCount++;
+			}
+		}
+
+		if (options.UpdateGolden && !m_saveTimings(timingsFile, newTimings))
+			failedCount++;
+
+		printf("%d/%d projects passed\n", (int)options.ProjectFiles.size() - failedCount, (int)options.ProjectFiles.size());
+
+		return failedCount == 0 ? 0 : 1;
+	}
+	int HeadlessEngine::Microbench(const CommandLineOptionParser& options)
+	{
+		Logger::Get().Log("Running in micro benchmark mode");
+
+		if (!Create())
+			return 1;
+
+		std::error_code errCode;
+		std::string tempDir = (ghc::filesystem::temp_directory_path(errCode) / "SHADERed_microbench").generic_string();
+		ghc::filesystem::create_directories(tempDir, errCode);
+
+		// the hot paths log a lot - don't measure the logger
+		bool logEnabled = Settings::Instance().General.Log;
+		Settings::Instance().General.Log = false;
+
+		MicroBenchmark bench(m_interface, tempDir);
+		bench.SetFilter(options.BenchFilter);
+		bench.SetSampleCount(options.SampleCount);
+		bench.RunAll();
+
+		Settings::Instance().General.Log = logEnabled;
+
+		ghc::filesystem::remove_all(tempDir, errCode);
+
+		std::string report = bench.GetReport();
+		if (options.OutputPath.empty())
+			printf("%s", report.c_str());
+		else {
+			std::ofstream reportFile(options.OutputPath);
+			if (!reportFile.is_open()) {
+				Logger::Get().Log("Failed to write the micro benchmark report to " + options.OutputPath, true);
+				return 1;
+			}
+			reportFile << report;
+			reportFile.close();
+		}
+
+		return bench.GetResults().size() > 0 ? 0 : 1;
+	}
+	std::string HeadlessEngine::m_jsonStats(std::vector<float> samples)
+	{
+		if (samples.size() == 0)
+			return "null";
+
+		std::sort(samples.begin(), samples.end());
+
+		// nearest-rank percentile
+		auto percentile = [&](float p) -> float {
+			int rank = (int)std::ceil(p / 100.0f * samples.size());
+			return samples[std::max(0, std::min<int>(rank, samples.size()) - 1)];
+		};
+
+		double sum = 0.0;
+		for (float sample : samples)
+			sum += sample;
+
+		std::stringstream ret;
+		ret << std::fixed << std::setprecision(4);
+		ret << "{ \"min\": " << samples[0];
+		ret << ", \"avg\": " << sum / samples.size();
+		ret << ", \"p95\": " << percentile(95.0f);
+		ret << ", \"p99\": " << percentile(99.0f);
+		ret << " }";
+
+		return ret.str();
+	}
+	std::string HeadlessEngine::m_jsonEscape(const std::string& str)
+	{
+		std::string ret;
+		ret.reserve(str.size());
+		for (char c : str) {
+			if (c == '"' || c == '\\') {
+				ret += '\\';
+				ret += c;
+			} else if (c == '\n')
+				ret += "\\n";
+			else if ((unsigned char)c >= 0x20)
+				ret += c;
+		}
+		return ret;
+	}
+	const char* HeadlessEngine::m_getItemTypeName(PipelineItem::ItemType type)
+	{
+		switch (type) {
+		case PipelineItem::ItemType::ShaderPass: return "ShaderPass";
+		case PipelineItem::ItemType::ComputePass: return "ComputePass";
+		case PipelineItem::ItemType::AudioPass: return "AudioPass";
+		case PipelineItem::ItemType::PluginItem: return "PluginItem";
+		case PipelineItem::ItemType::Geometry: return "Geometry";
+		case PipelineItem::ItemType::Model: return "Model";
+		case PipelineItem::ItemType::RenderState: return "RenderState";
+		default: return "Unknown";
+		}
+	}
+	std::vector<unsigned char> HeadlessEngine::m_readTexture(GLuint tex, int width, int height)
+	{
+		std::vector<unsigned char> pixels(width * height * 4);
+
+		glBindTexture(GL_TEXTURE_2D, tex);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		return pixels;
+	}
+	bool HeadlessEngine::m_saveTexture(GLuint tex, int width, int height, const std::string& file)
+	{
+		if (width <= 0 || height <= 0)
+			return false;
+
+		std::vector<unsigned char> pixels = m_readTexture(tex, width, height);
+
+		bool ret = stbi_write_png(file.c_str(), width, height, 4, pixels.data(), width * 4) != 0;
+		if (ret)
+			printf("Saved %s\n", file.c_str());
+		else
+			Logger::Get().Log("Failed to save " + file, true);
+
+		return ret;
+	}
+	int HeadlessEngine::m_compareImages(const unsigned char* img1, const unsigned char* img2, int width, int height, float threshold, std::vector<unsigned char>& diff)
+	{
+		// YIQ color difference (same metric as pixelmatch), colors are blended with white using their alpha
+		const float maxDelta = 35215.0f * threshold * threshold;
+
+		auto blend = [](unsigned char c, float a) -> float {
+			return 255.0f + (c - 255.0f) * a;
+		};
+
+		diff.resize(width * height * 4);
+
+		int diffCount = 0;
+		for (int i = 0; i < width * height; i++) {
+			const unsigned char* p1 = img1 + i * 4;
+			const unsigned char* p2 = img2 + i * 4;
+			unsigned char* d = diff.data() + i * 4;
+
+			float a1 = p1[3] / 255.0f, a2 = p2[3] / 255.0f;
+			float r1 = blend(p1[0], a1), g1 = blend(p1[1], a1), b1 = blend(p1[2], a1);
+			float r2 = blend(p2[0], a2), g2 = blend(p2[1], a2), b2 = blend(p2[2], a2);
+
+			float y = (r1 - r2) * 0.29889531f + (g1 - g2) * 0.58662247f + (b1 - b2) * 0.11448223f;
+			float iq = (r1 - r2) * 0.59597799f - (g1 - g2) * 0.27417610f - (b1 - b2) * 0.32180189f;
+			float q = (r1 - r2) * 0.21147017f - (g1 - g2) * 0.52261711f + (b1 - b2) * 0.31114694f;
+			float delta = 0.5053f * y * y + 0.299f * iq * iq + 0.1957f * q * q;
+
+			if (delta > maxDelta) {
+				d[0] = 255; d[1] = 0; d[2] = 0;
+				diffCount++;
+			} else {
+				// faded grayscale of the original image
+				unsigned char gray = (unsigned char)(255.0f + (r1 * 0.29889531f + g1 * 0.58662247f + b1 * 0.11448223f - 255.0f) * 0.1f);
+				d[0] = d[1] = d[2] = gray;
+			}
+			d[3] = 255;
+		}
+
+		return diffCount;
+	}
+	std::string HeadlessEngine::m_getProjectKey(const std::string& workingDir, const std::string& file)
+	{
+		std::error_code errCode;
+		ghc::filesystem::path rel = ghc::filesystem::relative(file, workingDir, errCode);
+		std::string key = (errCode || rel.empty()) ? ghc::filesystem::path(file).generic_string() : rel.generic_string();
+
+		if (key.size() > 5 && key.substr(key.size() - 5) == ".sprj")
+			key = key.substr(0, key.size() - 5);
+
+		for (char& c : key)
+			if (c == '/' || c == '\\' || c == ':' || c == ' ')
+				c = '_';
+		while (!key.empty() && (key[0] == '_' || key[0] == '.'))
+			key.erase(0, 1);
+
+		return key;
+	}
+	std::map<std::string, float> HeadlessEngine::m_loadTimings(const std::string& file)
+	{
+		std::map<std::string, float> ret;
+
+		std::ifstream timings(file);
+		std::string key;
+		float time;
+		while (timings >> key >> time)
+			ret[key] = time;
+
+		return ret;
+	}
+	bool HeadlessEngine::m_saveTimings(const std::string& file, const std::map<std::string, float>& timings)
+	{
+		std::ofstream out(file);
+		if (!out.is_open()) {
+			Logger::Get().Log("Failed to write the timings to " + file, true);
+			return false;
+		}
+
+		out << std::fixed << std::setprecision(3);
+		for (const auto& timing : timings)
+			out << timing.first << " " << timing.second << std::endl;
+
+		return true;
+	}
+}
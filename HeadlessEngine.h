@@ -0,0 +1,62 @@
+#pragma once
+#include "InterfaceManager.h"
+#include "Engine/OffscreenContext.h"
+#include "Objects/CommandLineOptionParser.h"
+
+#include <map>
+
+namespace ed
+{
+	// renders a project without any UI - used by the --headless command line mode
+	class HeadlessEngine
+	{
+	public:
+		HeadlessEngine();
+		~HeadlessEngine();
+
+		bool Create();
+		void Destroy();
+
+		bool Open(const std::string& file);
+
+		// render a single frame at the given time
+		void Render(int width, int height, float time, float delta, int frameIndex);
+
+		// save the window and the render textures to the output directory (frame == -1 -> don't add frame number to the file name)
+		bool Save(const std::string& outDir, int frame, const std::vector<std::string>& filter);
+
+		// run the whole --headless mode, returns the process exit code
+		int Run(const CommandLineOptionParser& options);
+
+		// run the whole --benchmark mode, returns the process exit code
+		int Benchmark(const CommandLineOptionParser& options);
+
+		// run the whole --compile mode, returns the process exit code
+		int Compile(const CommandLineOptionParser& options);
+
+		// run the whole --regression mode, returns the process exit code
+		int Regression(const CommandLineOptionParser& options);
+
+		// run the whole --microbench mode, returns the process exit code
+		int Microbench(const CommandLineOptionParser& options);
+
+		inline InterfaceManager& Interface() { return *m_interface; }
+
+	private:
+		std::vector<unsigned char> m_readTexture(GLuint tex, int width, int height); // RGBA8
+		bool m_saveTexture(GLuint tex, int width, int height, const std::string& file);
+
+		// compare two RGBA8 images, returns the number of different pixels and fills the diff image
+		int m_compareImages(const unsigned char* img1, const unsigned char* img2, int width, int height, float threshold, std::vector<unsigned char>& diff);
+		std::string m_getProjectKey(const std::string& workingDir, const std::string& file);
+		std::map<std::string, float> m_loadTimings(const std::string& file);
+		bool m_saveTimings(const std::string& file, const std::map<std::string, float>& timings);
+
+		std::string m_jsonStats(std::vector<float> samples); // min, avg, p95 & p99 as a JSON object
+		std::string m_jsonEscape(const std::string& str);
+		const char* m_getItemTypeName(PipelineItem::ItemType type);
+
+		eng::OffscreenContext m_context;
+		InterfaceManager* m_interface;
+	};
+}
@@ -2,6 +2,8 @@
 #include "GUIManager.h"
 #include "Objects/ShaderTranscompiler.h"
 
+#include "Engine/GLCallCounterHooks.h"
+
 namespace ed
 {
 	void copyFloatData(eng::Model::Mesh::Vertex& out, GLfloat* bufData)
@@ -6,6 +6,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "../Engine/GLCallCounterHooks.h"
+
 namespace ed
 {
 	AudioShaderStream::AudioShaderStream()
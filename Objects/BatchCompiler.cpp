@@ -0,0 +1,278 @@
+#include "BatchCompiler.h"
+#include "ShaderTranscompiler.h"
+#include "ShaderPreprocessor.h"
+#include "PipelineManager.h"
+#include "ProjectParser.h"
+#include "Settings.h"
+#include "Logger.h"
+#include "../Engine/GLUtils.h"
+
+#include <ghc/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+namespace ed
+{
+	BatchCompiler::BatchCompiler()
+	{
+		m_computeSupported = true;
+		m_exit = false;
+	}
+	BatchCompiler::~BatchCompiler()
+	{
+		Stop();
+
+		for (auto pass : m_pending)
+			delete pass;
+		m_pending.clear();
+	}
+	void BatchCompiler::Start(int threadCount)
+	{
+		m_exit = false;
+		threadCount = std::max(1, threadCount);
+
+		Logger::Get().Log("Starting " + std::to_string(threadCount) + " batch compiler threads");
+
+		for (int i = 0; i < threadCount; i++)
+			m_workers.push_back(std::thread(&BatchCompiler::m_worker, this));
+	}
+	void BatchCompiler::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_exit = true;
+		}
+		m_queueCV.notify_all();
+
+		for (auto& worker : m_workers)
+			if (worker.joinable())
+				worker.join();
+		m_workers.clear();
+	}
+	void BatchCompiler::AddProject(const std::string& file, PipelineManager* pipeline, ProjectParser* project)
+	{
+		std::vector<PassJob*> passes;
+
+		for (PipelineItem* item : pipeline->GetList()) {
+			PassJob* pass = nullptr;
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* data = (pipe::ShaderPass*)item->Data;
+
+				pass = new PassJob();
+
+				StageJob vs, ps;
+				vs.Stage = 0;
+				vs.File = project->GetProjectPath(data->VSPath);
+				vs.Entry = data->VSEntry;
+				ps.Stage = 1;
+				ps.File = project->GetProjectPath(data->PSPath);
+				ps.Entry = data->PSEntry;
+
+				pass->Stages.push_back(vs);
+				pass->Stages.push_back(ps);
+
+				if (data->GSUsed && strlen(data->GSEntry) > 0 && strlen(data->GSPath) > 0) {
+					StageJob gs;
+					gs.Stage = 2;
+					gs.File = project->GetProjectPath(data->GSPath);
+					gs.Entry = data->GSEntry;
+					pass->Stages.push_back(gs);
+				}
+
+				for (auto& stage : pass->Stages) {
+					stage.Macros = data->Macros;
+					stage.GSUsed = data->GSUsed;
+				}
+			}
+			else if (item->Type == PipelineItem::ItemType::ComputePass && m_computeSupported) {
+				pipe::ComputePass* data = (pipe::ComputePass*)item->Data;
+
+				pass = new PassJob();
+
+				StageJob cs;
+				cs.Stage = 3;
+				cs.File = project->GetProjectPath(data->Path);
+				cs.Entry = data->Entry;
+				cs.Macros = data->Macros;
+				cs.GSUsed = false;
+				pass->Stages.push_back(cs);
+			}
+
+			if (pass == nullptr)
+				continue;
+
+			pass->Project = file;
+			pass->ProjectDirectory = project->GetProjectDirectory();
+			pass->IncludePaths = Settings::Instance().Project.IncludePaths;
+			pass->Pass = item->Name;
+			pass->Remaining = pass->Stages.size();
+
+			for (auto& stage : pass->Stages) {
+				stage.Language = ShaderTranscompiler::GetShaderTypeFromExtension(stage.File);
+				stage.LineBias = 0;
+				stage.Failed = false;
+				stage.Messages.CurrentItem = pass->Pass;
+				stage.Messages.CurrentItemType = stage.Stage;
+			}
+
+			passes.push_back(pass);
+		}
+
+		// queue the stages - PassJob objects are owned by m_pending from now on
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (PassJob* pass : passes) {
+				m_pending.push_back(pass);
+				for (int i = 0; i < pass->Stages.size(); i++)
+					m_queue.push_back(std::make_pair(pass, i));
+			}
+		}
+		m_queueCV.notify_all();
+	}
+	void BatchCompiler::Link(bool wait)
+	{
+		while (!m_pending.empty()) {
+			PassJob* pass = m_pending.front();
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if (pass->Remaining > 0) {
+					if (!wait)
+						return;
+					m_doneCV.wait(lock, [&] { return pass->Remaining == 0; });
+				}
+			}
+
+			m_link(pass);
+
+			m_pending.pop_front();
+			delete pass;
+		}
+	}
+	void BatchCompiler::m_worker()
+	{
+		while (true) {
+			std::pair<PassJob*, int> job;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_queueCV.wait(lock, [&] { return m_exit || !m_queue.empty(); });
+
+				if (m_queue.empty())
+					return;
+
+				job = m_queue.front();
+				m_queue.pop_front();
+			}
+
+			m_process(job.first, job.first->Stages[job.second]);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				job.first->Remaining--;
+			}
+			m_doneCV.notify_all();
+		}
+	}
+	void BatchCompiler::m_process(PassJob* pass, StageJob& stage)
+	{
+		std::ifstream file(stage.File);
+		if (!file.is_open()) {
+			stage.Messages.Add(MessageStack::Type::Error, pass->Pass, "Failed to open file " + stage.File, -1, stage.Stage);
+			stage.Failed = true;
+			return;
+		}
+		std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		file.close();
+
+		if (stage.Language == ShaderLanguage::GLSL) {
+			stage.Source = content;
+			ShaderPreprocessor::ResolveIncludes(stage.Source, pass->IncludePaths, [&](const std::string& path, std::string& incContent) -> bool {
+				std::string actualPath = m_getProjectPath(pass, path);
+				if (!ghc::filesystem::exists(actualPath))
+					return false;
+
+				std::ifstream incFile(actualPath);
+				incContent = std::string((std::istreambuf_iterator<char>(incFile)), std::istreambuf_iterator<char>());
+				return true;
+			}, &stage.Messages, pass->Pass, stage.LineBias);
+			ShaderPreprocessor::ApplyMacros(stage.Source, stage.Macros);
+		} else { // HLSL / VK
+			std::vector<std::string> includeDirs;
+			for (auto& path : pass->IncludePaths)
+				includeDirs.push_back(m_getProjectPath(pass, path));
+
+			stage.Source = ShaderTranscompiler::TranscompileSource(stage.Language, stage.File, content, stage.Stage, stage.Entry, stage.Macros, stage.GSUsed, &stage.Messages, includeDirs);
+			stage.Failed = stage.Source == "error";
+		}
+	}
+	void BatchCompiler::m_link(PassJob* pass)
+	{
+		static const GLenum stageType[] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER, GL_COMPUTE_SHADER };
+
+		GLchar cMsg[1024];
+
+		PassResult result;
+		result.Project = pass->Project;
+		result.Pass = pass->Pass;
+		result.Compiled = true;
+
+		std::vector<GLuint> shaders;
+		for (auto& stage : pass->Stages) {
+			std::vector<MessageStack::Message>& msgs = stage.Messages.GetMessages();
+			result.Messages.insert(result.Messages.end(), msgs.begin(), msgs.end());
+
+			if (stage.Failed) {
+				result.Compiled = false;
+				continue;
+			}
+
+			GLuint shader = gl::CompileShader(stageType[stage.Stage], stage.Source.c_str());
+			if (!gl::CheckShaderCompilationStatus(shader, cMsg)) {
+				try {
+					std::vector<MessageStack::Message> glMsgs = gl::ParseMessages(pass->Pass, stage.Stage, cMsg, stage.LineBias);
+					result.Messages.insert(result.Messages.end(), glMsgs.begin(), glMsgs.end());
+				} catch (std::exception&) {
+					// driver uses an unknown message format - a single batch item shouldn't stop the whole batch
+					result.Messages.push_back(MessageStack::Message(MessageStack::Type::Error, pass->Pass, cMsg, -1, stage.Stage));
+				}
+				result.Compiled = false;
+			}
+
+			shaders.push_back(shader);
+		}
+
+		if (result.Compiled) {
+			GLuint prog = glCreateProgram();
+			for (GLuint shader : shaders)
+				glAttachShader(prog, shader);
+			glLinkProgram(prog);
+
+			if (!gl::CheckShaderLinkStatus(prog, cMsg)) {
+				result.Messages.push_back(MessageStack::Message(MessageStack::Type::Error, pass->Pass, "Failed to link the program: " + std::string(cMsg)));
+				result.Compiled = false;
+			}
+
+			glDeleteProgram(prog);
+		} else
+			result.Messages.push_back(MessageStack::Message(MessageStack::Type::Error, pass->Pass, "Failed to compile the shader"));
+
+		for (GLuint shader : shaders)
+			glDeleteShader(shader);
+
+		m_results.push_back(result);
+	}
+	std::string BatchCompiler::m_getProjectPath(PassJob* pass, const std::string& to)
+	{
+		// same as ProjectParser::GetProjectPath, the ProjectParser might already have another project opened
+#if defined(_WIN32)
+		ghc::filesystem::path fTo(to);
+		if (fTo.is_absolute())
+			return to;
+#endif
+		const std::string& dir = pass->ProjectDirectory;
+		return ghc::filesystem::path(dir + ((dir.size() > 0 && dir[dir.size() - 1] == '/') ? "" : "/") + to).generic_string();
+	}
+}
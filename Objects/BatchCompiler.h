@@ -0,0 +1,90 @@
+#pragma once
+#include "MessageStack.h"
+#include "ShaderMacro.h"
+#include "ShaderLanguage.h"
+
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <string>
+
+namespace ed
+{
+	class PipelineManager;
+	class ProjectParser;
+
+	// compiles the shader & compute passes of many projects: preprocessing and glslang run on
+	// a pool of worker threads while the OpenGL compile & link is done on the thread that owns the context
+	class BatchCompiler
+	{
+	public:
+		struct PassResult
+		{
+			std::string Project;
+			std::string Pass;
+			bool Compiled;
+			std::vector<MessageStack::Message> Messages;
+		};
+
+		BatchCompiler();
+		~BatchCompiler();
+
+		void Start(int threadCount);
+		void Stop();
+
+		inline void SetComputeSupported(bool cs) { m_computeSupported = cs; }
+
+		// copy everything that the workers need from the currently opened project and queue it
+		void AddProject(const std::string& file, PipelineManager* pipeline, ProjectParser* project);
+
+		// link the passes whose sources are ready (in the order they were added), wait == block until everything is linked
+		void Link(bool wait);
+
+		inline const std::vector<PassResult>& GetResults() { return m_results; }
+
+	private:
+		struct StageJob
+		{
+			int Stage; // 0=VS, 1=PS, 2=GS, 3=CS
+			ShaderLanguage Language;
+			std::string File;
+			std::string Entry;
+			std::vector<ShaderMacro> Macros;
+			bool GSUsed;
+
+			// output
+			std::string Source;
+			int LineBias;
+			bool Failed;
+			MessageStack Messages;
+		};
+		struct PassJob
+		{
+			std::string Project;
+			std::string ProjectDirectory;
+			std::vector<std::string> IncludePaths;
+			std::string Pass;
+			std::vector<StageJob> Stages;
+			int Remaining; // number of stages that the workers still have to process
+		};
+
+		void m_worker();
+		void m_process(PassJob* pass, StageJob& stage);
+		void m_link(PassJob* pass);
+
+		std::string m_getProjectPath(PassJob* pass, const std::string& to);
+
+		bool m_computeSupported;
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_queueCV, m_doneCV;
+		std::deque<std::pair<PassJob*, int>> m_queue;
+		bool m_exit;
+
+		std::deque<PassJob*> m_pending; // waiting to be linked
+		std::vector<PassResult> m_results;
+	};
+}
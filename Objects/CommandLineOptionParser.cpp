@@ -0,0 +1,237 @@
+#include "CommandLineOptionParser.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <thread>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+namespace ed
+{
+	CommandLineOptionParser::CommandLineOptionParser()
+	{
+		LaunchUI = true;
+		Headless = false;
+		Benchmark = false;
+		Compile = false;
+		Regression = false;
+		Microbench = false;
+		ProjectFile = "";
+		OutputPath = "";
+		RenderWidth = 800;
+		RenderHeight = 600;
+		StartTime = 0.0f;
+		FPS = 60.0f;
+		FrameCount = 1;
+		FrameIndex = 0;
+		WarmupFrames = 10;
+		ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+		WorkingDirectory = "";
+		GoldenPath = "";
+		UpdateGolden = false;
+		PixelThreshold = 0.1f;
+		MaxDiffRatio = 0.001f;
+		TimeTolerance = 25.0f;
+		SampleCount = 30;
+		TraceFile = "";
+		ProfileStartup = false;
+		GLCallCounters = false;
+	}
+	void CommandLineOptionParser::Parse(const ghc::filesystem::path& cmdDir, int argc, char* argv[])
+	{
+		bool hasFrameCount = false;
+		WorkingDirectory = cmdDir.generic_string();
+
+		for (int i = 0; i < argc; i++) {
+			const char* arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (strcmp(arg, "--headless") == 0)
+				Headless = true;
+			else if (strcmp(arg, "--benchmark") == 0)
+				Benchmark = true;
+			else if (strcmp(arg, "--compile") == 0)
+				Compile = true;
+			else if (strcmp(arg, "--threads") == 0 && hasValue)
+				ThreadCount = std::max(1, atoi(argv[++i]));
+			else if (strcmp(arg, "--regression") == 0)
+				Regression = true;
+			else if (strcmp(arg, "--golden") == 0 && hasValue)
+				GoldenPath = m_resolvePath(cmdDir, argv[++i]);
+			else if (strcmp(arg, "--update-golden") == 0)
+				UpdateGolden = true;
+			else if (strcmp(arg, "--threshold") == 0 && hasValue)
+				PixelThreshold = std::max(0.0f, std::min(1.0f, (float)atof(argv[++i])));
+			else if (strcmp(arg, "--max-diff") == 0 && hasValue)
+				MaxDiffRatio = std::max(0.0f, (float)atof(argv[++i]));
+			else if (strcmp(arg, "--time-tolerance") == 0 && hasValue)
+				TimeTolerance = std::max(0.0f, (float)atof(argv[++i]));
+			else if (strcmp(arg, "--microbench") == 0)
+				Microbench = true;
+			else if (strcmp(arg, "--filter") == 0 && hasValue)
+				BenchFilter.push_back(argv[++i]);
+			else if (strcmp(arg, "--samples") == 0 && hasValue)
+				SampleCount = std::max(1, atoi(argv[++i]));
+			else if (strcmp(arg, "--trace") == 0 && hasValue)
+				TraceFile = m_resolvePath(cmdDir, argv[++i]);
+			else if (strcmp(arg, "--profile-startup") == 0)
+				ProfileStartup = true;
+			else if (strcmp(arg, "--gl-calls") == 0)
+				GLCallCounters = true;
+			else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+				PrintHelp();
+				LaunchUI = false;
+			}
+			else if ((strcmp(arg, "--output") == 0 || strcmp(arg, "-o") == 0) && hasValue)
+				OutputPath = m_resolvePath(cmdDir, argv[++i]);
+			else if (strcmp(arg, "--size") == 0 && hasValue) {
+				int w = 0, h = 0;
+				if (sscanf(argv[++i], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+					RenderWidth = w;
+					RenderHeight = h;
+				} else
+					Logger::Get().Log("Invalid --size value " + std::string(argv[i]) + ", expected WIDTHxHEIGHT", true);
+			}
+			else if (strcmp(arg, "--time") == 0 && hasValue)
+				StartTime = atof(argv[++i]);
+			else if (strcmp(arg, "--fps") == 0 && hasValue) {
+				FPS = atof(argv[++i]);
+				if (FPS <= 0.0f)
+					FPS = 60.0f;
+			}
+			else if (strcmp(arg, "--frames") == 0 && hasValue) {
+				FrameCount = std::max(1, atoi(argv[++i]));
+				hasFrameCount = true;
+			}
+			else if (strcmp(arg, "--warmup") == 0 && hasValue)
+				WarmupFrames = std::max(0, atoi(argv[++i]));
+			else if (strcmp(arg, "--frame-index") == 0 && hasValue)
+				FrameIndex = std::max(0, atoi(argv[++i]));
+			else if (strcmp(arg, "--rendertexture") == 0 && hasValue)
+				RenderTextures.push_back(argv[++i]);
+			else if (arg[0] != '-') {
+				std::string path = m_resolvePath(cmdDir, arg);
+				if (ProjectFile.empty())
+					ProjectFile = path;
+				m_addProjects(path);
+			}
+			else
+				Logger::Get().Log("Unknown command line option " + std::string(arg), true);
+		}
+
+		if (Headless || Benchmark) {
+			LaunchUI = false;
+
+			if (ProjectFile.empty()) {
+				printf("%s requires a project file\n", Benchmark ? "--benchmark" : "--headless");
+				Headless = Benchmark = false;
+			}
+		}
+		if (Compile || Regression) {
+			LaunchUI = false;
+			Headless = Benchmark = false;
+
+			if (ProjectFiles.empty()) {
+				printf("%s requires at least one project file\n", Compile ? "--compile" : "--regression");
+				Compile = Regression = false;
+			}
+			if (Regression && GoldenPath.empty()) {
+				printf("--regression requires --golden <dir>\n");
+				Regression = false;
+			}
+		}
+
+		if (Microbench) {
+			LaunchUI = false;
+			Headless = Benchmark = Compile = Regression = false;
+		}
+
+		// a single frame isn't enough for the percentiles
+		if (Benchmark && !hasFrameCount)
+			FrameCount = 100;
+		else if (Regression && !hasFrameCount)
+			FrameCount = 10;
+	}
+	void CommandLineOptionParser::PrintHelp()
+	{
+		printf("Usage: SHADERed [options] [project.sprj]\n\n");
+		printf("Options:\n");
+		printf("  -h, --help                 show this message\n");
+		printf("  --headless                 render the project without opening a window\n");
+		printf("  --benchmark                render the project without opening a window and print a JSON report with CPU/GPU time of each pipeline item\n");
+		printf("  --compile <projects...>    compile all the shader passes in the given projects (files, directories or wildcards) and print the errors\n");
+		printf("  --threads <n>              --compile: number of worker threads (default: number of cores)\n");
+		printf("  --regression <projects...> render the given projects (files, directories or wildcards) and compare them with the golden images & timings\n");
+		printf("  --golden <dir>             --regression: directory with the golden images and timings.txt\n");
+		printf("  --update-golden            --regression: overwrite the golden images and timings\n");
+		printf("  --threshold <0..1>         --regression: perceptual difference at which two pixels are considered different (default: 0.1)\n");
+		printf("  --max-diff <ratio>         --regression: max ratio of different pixels (default: 0.001)\n");
+		printf("  --time-tolerance <pct>     --regression: max render time increase in percent (default: 25)\n");
+		printf("  --microbench               measure the CPU side hot paths (project loading, transcompiler, FFT, picking, uniforms, ...) on synthetic inputs\n");
+		printf("  --filter <name>            --microbench: only run the benchmarks whose name starts with <name>, can be repeated\n");
+		printf("  --samples <n>              --microbench: number of samples taken by each benchmark (default: 30)\n");
+		printf("  --trace <file>             record the main loop, rendering and shader compilation and save it as a Chrome/Perfetto trace JSON on exit\n");
+		printf("  --profile-startup          print the time spent in each startup step and the time until the first interactive frame\n");
+		printf("  -o, --output <path>        --headless, --regression: directory in which the rendered images are saved (default: working directory)\n");
+		printf("                             --benchmark, --compile, --microbench: file in which the report is saved (default: stdout)\n");
+		printf("  --size <W>x<H>             size of the window render texture (default: 800x600)\n");
+		printf("  --time <seconds>           value of the Time variable in the first frame (default: 0)\n");
+		printf("  --fps <n>                  frames per second, TimeDelta == 1/n (default: 60)\n");
+		printf("  --frames <n>               number of frames to render (default: 1, --benchmark: 100, --regression: 10 timed frames)\n");
+		printf("  --warmup <n>               --benchmark: number of frames rendered before measuring (default: 10)\n");
+		printf("  --gl-calls                 --benchmark: count the GL calls made in each frame and add them to the report\n");
+		printf("  --frame-index <n>          value of the FrameIndex variable in the first frame (default: 0)\n");
+		printf("  --rendertexture <name>     only save this render texture (\"Window\" for the window), can be repeated\n");
+	}
+	std::string CommandLineOptionParser::m_resolvePath(const ghc::filesystem::path& cmdDir, const std::string& path)
+	{
+		ghc::filesystem::path argPath(path);
+		if (argPath.is_absolute())
+			return argPath.generic_string();
+
+		// the working directory is changed on startup, so relative paths are relative to the directory SHADERed was launched from
+		return (cmdDir / argPath).generic_string();
+	}
+	void CommandLineOptionParser::m_addProjects(const std::string& path)
+	{
+		std::error_code errCode;
+		ghc::filesystem::path fsPath(path);
+
+		// directory -> all the projects in it
+		if (ghc::filesystem::is_directory(fsPath, errCode)) {
+			std::vector<std::string> found;
+			for (const auto& entry : ghc::filesystem::recursive_directory_iterator(fsPath, errCode))
+				if (entry.is_regular_file() && entry.path().extension() == ".sprj")
+					found.push_back(entry.path().generic_string());
+
+			std::sort(found.begin(), found.end());
+			ProjectFiles.insert(ProjectFiles.end(), found.begin(), found.end());
+		}
+
+		// wildcard in the file name (for shells that don't expand them)
+		else if (fsPath.filename().string().find_first_of("*?") != std::string::npos) {
+			std::string pattern = fsPath.filename().string();
+			std::vector<std::string> found;
+			for (const auto& entry : ghc::filesystem::directory_iterator(fsPath.parent_path(), errCode))
+				if (entry.is_regular_file() && m_matchWildcard(pattern.c_str(), entry.path().filename().string().c_str()))
+					found.push_back(entry.path().generic_string());
+
+			std::sort(found.begin(), found.end());
+			ProjectFiles.insert(ProjectFiles.end(), found.begin(), found.end());
+		}
+
+		else
+			ProjectFiles.push_back(path);
+	}
+	bool CommandLineOptionParser::m_matchWildcard(const char* pattern, const char* str)
+	{
+		if (*pattern == 0)
+			return *str == 0;
+		if (*pattern == '*')
+			return m_matchWildcard(pattern + 1, str) || (*str != 0 && m_matchWildcard(pattern, str + 1));
+		if (*str != 0 && (*pattern == '?' || *pattern == *str))
+			return m_matchWildcard(pattern + 1, str + 1);
+		return false;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ghc/filesystem.hpp>
+
+namespace ed
+{
+	class CommandLineOptionParser
+	{
+	public:
+		CommandLineOptionParser();
+
+		// parse the arguments (without the executable path)
+		void Parse(const ghc::filesystem::path& cmdDir, int argc, char* argv[]);
+		void PrintHelp();
+
+		bool LaunchUI;			// false if a command line only mode (--headless, --benchmark, --compile, --regression, --microbench, --help) was requested
+		bool Headless;			// render the project without opening a window
+		bool Benchmark;			// measure the time spent on each pipeline item and print a JSON report
+		bool Compile;			// compile all the shader passes in the given projects and print the errors
+		bool Regression;		// render the given projects and compare them with the golden images & timings
+		bool Microbench;		// measure the CPU side hot paths on synthetic inputs
+		std::string ProjectFile;
+		std::vector<std::string> ProjectFiles; // all the projects passed through arguments (directories and wildcards are expanded)
+
+		std::string OutputPath;	// directory in which the rendered images are stored (--headless) or the report file (--benchmark)
+		std::vector<std::string> RenderTextures; // only save these render textures (empty == window + all render textures)
+		int RenderWidth, RenderHeight;
+		float StartTime;		// value of the Time system variable in the first frame
+		float FPS;				// TimeDelta == 1 / FPS
+		int FrameCount;			// number of frames to render
+		int FrameIndex;			// value of the FrameIndex system variable in the first frame
+		int WarmupFrames;		// number of frames rendered before the measurements start
+		int ThreadCount;		// number of --compile worker threads
+
+		std::string WorkingDirectory;	// directory from which SHADERed was launched
+		std::string GoldenPath;			// directory with the golden images and timings.txt
+		bool UpdateGolden;				// overwrite the golden images and timings instead of comparing
+		float PixelThreshold;			// max perceptual (YIQ) difference of two pixels that are considered equal, 0..1
+		float MaxDiffRatio;				// max ratio of differing pixels
+		float TimeTolerance;			// max allowed render time increase (in percent)
+
+		std::vector<std::string> BenchFilter;	// only run the micro benchmarks whose name starts with one of these
+		int SampleCount;						// number of samples taken by each micro benchmark
+
+		std::string TraceFile;	// record the trace zones and save them in this file on exit (Chrome trace format)
+		bool ProfileStartup;	// print the time spent in each startup step
+		bool GLCallCounters;	// --benchmark: count the GL calls and add them to the report
+
+	private:
+		std::string m_resolvePath(const ghc::filesystem::path& cmdDir, const std::string& path);
+		void m_addProjects(const std::string& path);
+		bool m_matchWildcard(const char* pattern, const char* str);
+	};
+}
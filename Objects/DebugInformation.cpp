@@ -321,14 +321,6 @@ namespace ed
 		bool isInstanced = false;
 		BufferObject* instanceBuffer = nullptr;
 
-		// update some values
-		auto& itemVarValues = m_renderer->GetItemVariableValues();
-
-		// update the value for this element
-		for (int k = 0; k < itemVarValues.size(); k++)
-			if (itemVarValues[k].Item == pixel.Object)
-				itemVarValues[k].Variable->Data = itemVarValues[k].NewValue->Data;
-
 		// update system variables
 		if (pixel.Object->Type == PipelineItem::ItemType::Geometry) {
 			pipe::GeometryItem* geoData = reinterpret_cast<pipe::GeometryItem*>(pixel.Object->Data);
@@ -452,24 +444,25 @@ namespace ed
 					for (ShaderVariable* var : passUniforms) {
 						if (strcmp(glob.Name.c_str(), var->Name) == 0) {
 							ShaderVariable::ValueType valType = var->GetType();
+							char* value = pass->Variables.GetValue(var, pixel.Object); // might be this item's value
 
 							bv_variable varValue;
 							switch (valType) {
-							case ShaderVariable::ValueType::Boolean1: varValue = bv_variable_create_uchar(var->AsBoolean()); break;
-							case ShaderVariable::ValueType::Boolean2: varValue = sd::Common::create_bool2(Engine.GetProgram(), glm::make_vec2<bool>(var->AsBooleanPtr())); break;
-							case ShaderVariable::ValueType::Boolean3: varValue = sd::Common::create_bool3(Engine.GetProgram(), glm::make_vec3<bool>(var->AsBooleanPtr())); break;
-							case ShaderVariable::ValueType::Boolean4: varValue = sd::Common::create_bool4(Engine.GetProgram(), glm::make_vec4<bool>(var->AsBooleanPtr())); break;
-							case ShaderVariable::ValueType::Integer1: varValue = bv_variable_create_int(var->AsInteger()); break;
-							case ShaderVariable::ValueType::Integer2: varValue = sd::Common::create_int2(Engine.GetProgram(), glm::make_vec2<int>(var->AsIntegerPtr())); break;
-							case ShaderVariable::ValueType::Integer3: varValue = sd::Common::create_int3(Engine.GetProgram(), glm::make_vec3<int>(var->AsIntegerPtr())); break;
-							case ShaderVariable::ValueType::Integer4: varValue = sd::Common::create_int4(Engine.GetProgram(), glm::make_vec4<int>(var->AsIntegerPtr())); break;
-							case ShaderVariable::ValueType::Float1: varValue = bv_variable_create_float(var->AsFloat()); break;
-							case ShaderVariable::ValueType::Float2: varValue = sd::Common::create_float2(Engine.GetProgram(), glm::make_vec2<float>(var->AsFloatPtr())); break;
-							case ShaderVariable::ValueType::Float3: varValue = sd::Common::create_float3(Engine.GetProgram(), glm::make_vec3<float>(var->AsFloatPtr())); break;
-							case ShaderVariable::ValueType::Float4: varValue = sd::Common::create_float4(Engine.GetProgram(), glm::make_vec4<float>(var->AsFloatPtr())); break;
-							case ShaderVariable::ValueType::Float2x2: varValue = sd::Common::create_mat(Engine.GetProgram(), m_lang == ed::ShaderLanguage::GLSL ? "mat2" : "float2x2", new sd::Matrix(glm::make_mat2x2(var->AsFloatPtr()), 2, 2)); break;
-							case ShaderVariable::ValueType::Float3x3: varValue = sd::Common::create_mat(Engine.GetProgram(), m_lang == ed::ShaderLanguage::GLSL ? "mat3" : "float3x3", new sd::Matrix(glm::make_mat3x3(var->AsFloatPtr()), 3, 3)); break;
-							case ShaderVariable::ValueType::Float4x4: varValue = sd::Common::create_mat(Engine.GetProgram(), m_lang == ed::ShaderLanguage::GLSL ? "mat4" : "float4x4", new sd::Matrix(glm::make_mat4x4(var->AsFloatPtr()), 4, 4)); break;
+							case ShaderVariable::ValueType::Boolean1: varValue = bv_variable_create_uchar(*(bool*)value); break;
+							case ShaderVariable::ValueType::Boolean2: varValue = sd::Common::create_bool2(Engine.GetProgram(), glm::make_vec2<bool>((bool*)value)); break;
+							case ShaderVariable::ValueType::Boolean3: varValue = sd::Common::create_bool3(Engine.GetProgram(), glm::make_vec3<bool>((bool*)value)); break;
+							case ShaderVariable::ValueType::Boolean4: varValue = sd::Common::create_bool4(Engine.GetProgram(), glm::make_vec4<bool>((bool*)value)); break;
+							case ShaderVariable::ValueType::Integer1: varValue = bv_variable_create_int(*(int*)value); break;
+							case ShaderVariable::ValueType::Integer2: varValue = sd::Common::create_int2(Engine.GetProgram(), glm::make_vec2<int>((int*)value)); break;
+							case ShaderVariable::ValueType::Integer3: varValue = sd::Common::create_int3(Engine.GetProgram(), glm::make_vec3<int>((int*)value)); break;
+							case ShaderVariable::ValueType::Integer4: varValue = sd::Common::create_int4(Engine.GetProgram(), glm::make_vec4<int>((int*)value)); break;
+							case ShaderVariable::ValueType::Float1: varValue = bv_variable_create_float(*(float*)value); break;
+							case ShaderVariable::ValueType::Float2: varValue = sd::Common::create_float2(Engine.GetProgram(), glm::make_vec2<float>((float*)value)); break;
+							case ShaderVariable::ValueType::Float3: varValue = sd::Common::create_float3(Engine.GetProgram(), glm::make_vec3<float>((float*)value)); break;
+							case ShaderVariable::ValueType::Float4: varValue = sd::Common::create_float4(Engine.GetProgram(), glm::make_vec4<float>((float*)value)); break;
+							case ShaderVariable::ValueType::Float2x2: varValue = sd::Common::create_mat(Engine.GetProgram(), m_lang == ed::ShaderLanguage::GLSL ? "mat2" : "float2x2", new sd::Matrix(glm::make_mat2x2((float*)value), 2, 2)); break;
+							case ShaderVariable::ValueType::Float3x3: varValue = sd::Common::create_mat(Engine.GetProgram(), m_lang == ed::ShaderLanguage::GLSL ? "mat3" : "float3x3", new sd::Matrix(glm::make_mat3x3((float*)value), 3, 3)); break;
+							case ShaderVariable::ValueType::Float4x4: varValue = sd::Common::create_mat(Engine.GetProgram(), m_lang == ed::ShaderLanguage::GLSL ? "mat4" : "float4x4", new sd::Matrix(glm::make_mat4x4((float*)value), 4, 4)); break;
 							}
 							Engine.SetGlobalValue(glob.Name, varValue);
 
@@ -780,14 +773,6 @@ namespace ed
 				Engine.SetGlobalValue("gl_FragCoord", "vec4", glm::vec4(m_pixel->Coordinate.x, m_pixel->Coordinate.y, Zw, interW));
 			}
 		}
-
-
-
-		// return old values
-		if (pixel.Object->Type == PipelineItem::ItemType::Geometry || pixel.Object->Type == PipelineItem::ItemType::Model)
-			for (int k = 0; k < itemVarValues.size(); k++)
-				if (itemVarValues[k].Item == pixel.Object)
-					itemVarValues[k].Variable->Data = itemVarValues[k].OldValue;
 	}
 	void DebugInformation::Fetch(int id)
 	{
@@ -9,6 +9,8 @@
 	#include <GL/gl.h>
 #endif
 
+#include "../Engine/GLCallCounterHooks.h"
+
 namespace ed
 {
 	void DefaultState::Bind()
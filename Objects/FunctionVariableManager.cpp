@@ -1,4 +1,5 @@
 #include "FunctionVariableManager.h"
+#include "ShaderVariableContainer.h"
 #include "CameraSnapshots.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -6,8 +7,11 @@
 
 namespace ed
 {
-	int FunctionVariableManager::CurrentIndex = 0;
 	std::vector<ed::ShaderVariable*> FunctionVariableManager::VariableList = std::vector<ed::ShaderVariable*>();
+	bool FunctionVariableManager::m_dirty = true;
+	std::vector<const ShaderVariableContainer*> FunctionVariableManager::m_containers = std::vector<const ShaderVariableContainer*>();
+	std::vector<ed::ShaderVariable*> FunctionVariableManager::m_order = std::vector<ed::ShaderVariable*>();
+	std::unordered_map<ed::ShaderVariable*, ed::ShaderVariable*> FunctionVariableManager::m_sources = std::unordered_map<ed::ShaderVariable*, ed::ShaderVariable*>();
 
 	size_t FunctionVariableManager::GetArgumentCount(ed::FunctionShaderVariable func)
 	{
@@ -42,6 +46,7 @@ namespace ed
 		if (func == FunctionShaderVariable::PluginFunction)
 			args = var->PluginFuncData.Owner->GetVariableFunctionArgSpaceSize(var->PluginFuncData.Name, (plugin::VariableType)var->GetType());
 		var->Function = func;
+		Invalidate();
 
 		if (func == ed::FunctionShaderVariable::Pointer || func == ed::FunctionShaderVariable::CameraSnapshot)
 			args = sizeof(char) * VARIABLE_NAME_LENGTH;
@@ -114,17 +119,60 @@ namespace ed
 			return true;
 		return false;
 	}
-	void FunctionVariableManager::AddToList(ed::ShaderVariable* var)
+	void FunctionVariableManager::Invalidate()
 	{
-		int& curIndex = FunctionVariableManager::CurrentIndex;
-		std::vector<ed::ShaderVariable*>& varList = FunctionVariableManager::VariableList;
-		for (int i = 0; i < curIndex; i++)
-			if(varList[i] == var)
-				return; // already exists
-		if (curIndex % 20 == 0)
-			varList.resize(curIndex+20);
-		varList[curIndex] = var;
-		curIndex++;
+		m_dirty = true;
+	}
+	void FunctionVariableManager::Evaluate(const std::vector<const ShaderVariableContainer*>& containers)
+	{
+		if (m_dirty || containers != m_containers)
+			m_build(containers);
+
+		for (ShaderVariable* var : m_order)
+			Update(var);
+	}
+	void FunctionVariableManager::m_build(const std::vector<const ShaderVariableContainer*>& containers)
+	{
+		m_dirty = false;
+		m_containers = containers;
+
+		VariableList.clear();
+		m_order.clear();
+		m_sources.clear();
+
+		// if two passes have a variable with the same name, pointers use the first one
+		std::unordered_map<std::string, ShaderVariable*> names;
+		for (const ShaderVariableContainer* container : containers)
+			for (ShaderVariable* var : container->GetVariables()) {
+				VariableList.push_back(var);
+				names.insert(std::make_pair(std::string(var->Name), var));
+			}
+
+		for (ShaderVariable* var : VariableList) {
+			if (var->Function != FunctionShaderVariable::Pointer || var->Arguments == nullptr)
+				continue;
+
+			auto src = names.find(var->Arguments);
+			if (src != names.end() && src->second != var)
+				m_sources[var] = src->second;
+		}
+
+		std::unordered_map<ShaderVariable*, int> state;
+		for (ShaderVariable* var : VariableList)
+			if (var->Function != FunctionShaderVariable::None)
+				m_visit(var, state);
+	}
+	void FunctionVariableManager::m_visit(ed::ShaderVariable* var, std::unordered_map<ed::ShaderVariable*, int>& state)
+	{
+		if (state[var] != 0)
+			return; // already added or a cycle of pointers
+		state[var] = 1;
+
+		auto src = m_sources.find(var);
+		if (src != m_sources.end() && src->second->Function != FunctionShaderVariable::None)
+			m_visit(src->second, state);
+
+		m_order.push_back(var);
 	}
 	void FunctionVariableManager::Update(ed::ShaderVariable* var)
 	{
@@ -133,16 +181,9 @@ namespace ed
 			return;
 
 		if (var->Function == FunctionShaderVariable::Pointer) {
-			std::vector<ed::ShaderVariable*>& varList = FunctionVariableManager::VariableList;
-			for (int i = 0; i < varList.size(); i++) {
-				if (varList[i] == nullptr)
-					continue;
-
-				if (strcmp(varList[i]->Name, var->Arguments) == 0) {
-					memcpy(var->Data, varList[i]->Data, ShaderVariable::GetSize(var->GetType()));
-					break;
-				}
-			}
+			auto src = m_sources.find(var);
+			if (src != m_sources.end())
+				memcpy(var->Data, src->second->Data, ShaderVariable::GetSize(var->GetType()));
 		}
 		else if (var->Function == FunctionShaderVariable::CameraSnapshot) {
 			glm::mat4 camVal = CameraSnapshots::Get(var->Arguments);
@@ -316,7 +357,10 @@ namespace ed
 	void FunctionVariableManager::ClearVariableList()
 	{
 		FunctionVariableManager::VariableList.clear();
-		FunctionVariableManager::CurrentIndex = 0;
+		m_containers.clear();
+		m_order.clear();
+		m_sources.clear();
+		m_dirty = true;
 	}
 	float * FunctionVariableManager::LoadFloat(char* data, int index)
 	{
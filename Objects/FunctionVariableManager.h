@@ -1,22 +1,38 @@
 #pragma once
 #include "ShaderVariable.h"
 #include <vector>
+#include <unordered_map>
 
 namespace ed
 {
+	class ShaderVariableContainer;
+
 	class FunctionVariableManager
 	{
 	public:
 		static size_t GetArgumentCount(ed::FunctionShaderVariable func);
 		static void AllocateArgumentSpace(ed::ShaderVariable* var, ed::FunctionShaderVariable func);
 		static bool HasValidReturnType(ShaderVariable::ValueType ret, ed::FunctionShaderVariable func);
-		static void AddToList(ed::ShaderVariable* var);
 		static void Update(ed::ShaderVariable* var);
 		static float* LoadFloat(char* data, int index);
 
+		// the dependency graph is rebuilt on the next Evaluate() - call it when variables are added, removed or retargeted
+		static void Invalidate();
+
+		// update all the function variables once per frame, pointers after the variables they point to
+		static void Evaluate(const std::vector<const ShaderVariableContainer*>& containers);
+
 		static void ClearVariableList();
 
-		static int CurrentIndex;
-		static std::vector<ed::ShaderVariable*> VariableList;
+		static std::vector<ed::ShaderVariable*> VariableList; // all variables in the pipeline order
+
+	private:
+		static void m_build(const std::vector<const ShaderVariableContainer*>& containers);
+		static void m_visit(ed::ShaderVariable* var, std::unordered_map<ed::ShaderVariable*, int>& state);
+
+		static bool m_dirty;
+		static std::vector<const ShaderVariableContainer*> m_containers;
+		static std::vector<ed::ShaderVariable*> m_order;	// function variables in the evaluation order
+		static std::unordered_map<ed::ShaderVariable*, ed::ShaderVariable*> m_sources; // Pointer -> variable it points to
 	};
 }
\ No newline at end of file
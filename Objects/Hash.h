@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#define HASH_SEED 14695981039346656037ull
+
+namespace ed
+{
+	// FNV-1a - used to check if the inputs of a pass have changed since the last frame
+	inline void HashBytes(uint64_t& hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	}
+	template<typename T>
+	inline void HashValue(uint64_t& hash, const T& value)
+	{
+		HashBytes(hash, &value, sizeof(T));
+	}
+}
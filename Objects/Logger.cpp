@@ -1,73 +1,184 @@
 #include "Logger.h"
 #include "Settings.h"
 #include <fstream>
-#include <ctime>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <vector>
+#include <stdint.h>
 
 namespace ed
 {
+	Logger::Logger()
+	{
+		Stack = nullptr;
+
+		for (size_t i = 0; i < LOGGER_QUEUE_SIZE; i++)
+			m_queue[i].Sequence.store(i, std::memory_order_relaxed);
+		m_enqueuePos = 0;
+		m_dequeuePos = 0;
+		m_written = 0;
+
+		m_running = true;
+		m_thread = std::thread(&Logger::m_writer, this);
+	}
+	Logger::~Logger()
+	{
+		m_running = false;
+		m_wake.notify_one();
+		if (m_thread.joinable())
+			m_thread.join();
+	}
 	void Logger::Log(const std::string& msg, bool error, const std::string& file, int line)
 	{
-		if (!Settings::Instance().General.Log)
+		const Settings& settings = Settings::Instance();
+		if (!settings.General.Log)
+			return;
+
+		// bounded MPMC queue (D. Vyukov) with a single consumer
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		Entry* entry = nullptr;
+		while (true) {
+			entry = &m_queue[pos & (LOGGER_QUEUE_SIZE - 1)];
+			size_t seq = entry->Sequence.load(std::memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+
+			if (dif == 0) {
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (dif < 0) {
+				// queue is full - let the writer catch up
+				m_wake.notify_one();
+				std::this_thread::yield();
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			} else
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+		}
+
+		entry->Time = time(0);
+		entry->Error = error;
+		entry->Terminal = settings.General.PipeLogsToTerminal;
+		entry->Stream = settings.General.StreamLogs;
+		entry->Line = line;
+		entry->Message = msg;
+		entry->File = file;
+		entry->Sequence.store(pos + 1, std::memory_order_release);
+	}
+	void Logger::Save()
+	{
+		Flush();
+
+		if (!Settings::Instance().General.Log || Settings::Instance().General.StreamLogs)
 			return;
 
 		time_t now = time(0);
 		tm* ltm = localtime(&now);
 
+		std::lock_guard<std::mutex> lock(m_msgsMutex);
+
+		std::ofstream file("log.txt");
+		file << "Log -> " << ltm->tm_mday << "." << ltm->tm_mon + 1 << "." << 1900 + ltm->tm_year << "\n";
+
+		for (auto& line : m_msgs)
+			file << line << std::endl;
+
+		file.close();
+	}
+	void Logger::Flush()
+	{
+		if (!m_running)
+			return;
+
+		size_t target = m_enqueuePos.load(std::memory_order_acquire);
+		while (m_written.load(std::memory_order_acquire) < target) {
+			m_wake.notify_one();
+			std::this_thread::yield();
+		}
+	}
+	void Logger::m_writer()
+	{
+		std::string terminal, stream;
+		std::vector<std::string> msgs;
+
+		while (true) {
+			bool running = m_running;
+
+			// take everything that's been published so far
+			while (true) {
+				Entry& entry = m_queue[m_dequeuePos & (LOGGER_QUEUE_SIZE - 1)];
+				if (entry.Sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+					break;
+
+				std::string line = m_format(entry);
+				if (entry.Terminal)
+					terminal += line + "\n";
+				if (entry.Stream)
+					stream += line + "\n";
+				else
+					msgs.push_back(std::move(line));
+
+				entry.Message.clear();
+				entry.File.clear();
+				entry.Sequence.store(m_dequeuePos + LOGGER_QUEUE_SIZE, std::memory_order_release);
+				m_dequeuePos++;
+			}
+
+			// write the batch
+			if (!terminal.empty()) {
+				std::cout << terminal << std::flush;
+				terminal.clear();
+			}
+			if (!stream.empty()) {
+				std::ofstream log("log.txt", std::ios_base::app | std::ios_base::out);
+				log << stream;
+				log.close();
+				stream.clear();
+			}
+			if (!msgs.empty()) {
+				std::lock_guard<std::mutex> lock(m_msgsMutex);
+				m_msgs.insert(m_msgs.end(), std::make_move_iterator(msgs.begin()), std::make_move_iterator(msgs.end()));
+				msgs.clear();
+			}
+
+			m_written.store(m_dequeuePos, std::memory_order_release);
+
+			if (!running)
+				break;
+
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_wake.wait_for(lock, std::chrono::milliseconds(20));
+		}
+	}
+	std::string Logger::m_format(const Entry& entry)
+	{
+		tm* ltm = localtime(&entry.Time);
+
 		std::stringstream data;
 
 		// time
 		data << "[" << std::setw(2) << std::setfill('0') << ltm->tm_hour << ":" << std::setw(2) << std::setfill('0') << ltm->tm_min << ":" << std::setw(2) << std::setfill('0') << ltm->tm_sec << "] ";
 
 		// file and line
-		if (file.size() != 0)
-			data << "<" << file;
+		if (entry.File.size() != 0)
+			data << "<" << entry.File;
 
-		if (line != -1) {
-			if (file.size() == 0)
+		if (entry.Line != -1) {
+			if (entry.File.size() == 0)
 				data << "<";
 			else data << " ";
-			data << "at line " << line;
+			data << "at line " << entry.Line;
 		}
 
-		if (file.size() != 0 || line != -1)
+		if (entry.File.size() != 0 || entry.Line != -1)
 			data << "> ";
 
 		// error
-		if (error)
+		if (entry.Error)
 			data << "(ERROR) ";
 
 		// message
-		data << msg;
-
-
-		if (Settings::Instance().General.PipeLogsToTerminal)
-			std::cout << data.str() << std::endl;
-
-		if (Settings::Instance().General.StreamLogs) {
-			std::ofstream log("log.txt", std::ios_base::app | std::ios_base::out);
-    		log << data.str() << std::endl;
-			log.close();
-		}
-		else
-			m_msgs.push_back(data.str());
-	}
-	void Logger::Save()
-	{
-		if (!Settings::Instance().General.Log || Settings::Instance().General.StreamLogs)
-			return;
+		data << entry.Message;
 
-		time_t now = time(0);
-		tm* ltm = localtime(&now);
-
-		std::ofstream file("log.txt");
-		file << "Log -> " << ltm->tm_mday << "." << ltm->tm_mon + 1 << "." << 1900 + ltm->tm_year << "\n";
-
-		for (auto& line : m_msgs)
-			file << line << std::endl;
-
-		file.close();
+		return data.str();
 	}
-}
\ No newline at end of file
+}
@@ -1,18 +1,23 @@
 #pragma once
 #include "MessageStack.h"
+#include <condition_variable>
+#include <atomic>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <ctime>
+
+#define LOGGER_QUEUE_SIZE 1024 // has to be a power of two
 
 namespace ed
 {
+	// Log() only pushes the message to a lock-free queue - formatting and writing is done
+	// in batches on a separate thread, so it can be called from any thread
 	class Logger
 	{
 	public:
 		MessageStack* Stack;
 
-		Logger() {
-			Stack = nullptr;
-		}
-
 		static Logger& Get() {
 			static Logger ret;
 			return ret;
@@ -21,7 +26,39 @@ namespace ed
 		void Log(const std::string& msg, bool error = false, const std::string& file = "", int line = -1);
 		void Save();
 
+		// wait until all the messages logged before this call are processed
+		void Flush();
+
 	private:
+		Logger();
+		~Logger();
+
+		struct Entry
+		{
+			std::atomic<size_t> Sequence;
+			time_t Time;
+			bool Error;
+			bool Terminal;	// General.PipeLogsToTerminal at the time of logging
+			bool Stream;	// General.StreamLogs at the time of logging
+			int Line;
+			std::string Message;
+			std::string File;
+		};
+
+		void m_writer();
+		std::string m_format(const Entry& entry);
+
+		Entry m_queue[LOGGER_QUEUE_SIZE];
+		std::atomic<size_t> m_enqueuePos;
+		size_t m_dequeuePos;			// only used by the writer thread
+		std::atomic<size_t> m_written;	// number of processed messages
+
+		std::atomic<bool> m_running;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wake;
+		std::thread m_thread;
+
+		std::mutex m_msgsMutex; // m_msgs is filled by the writer thread and saved by Save()
 		std::vector<std::string> m_msgs;
 	};
-}
\ No newline at end of file
+}
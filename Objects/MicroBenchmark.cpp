@@ -0,0 +1,523 @@
+#include "MicroBenchmark.h"
+#include "AudioAnalyzer.h"
+#include "FunctionVariableManager.h"
+#include "ShaderTranscompiler.h"
+#include "ShaderVariableContainer.h"
+#include "../InterfaceManager.h"
+#include "../Engine/GLUtils.h"
+#include "../Engine/Model.h"
+#include "../Engine/Ray.h"
+
+#include <ghc/filesystem.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdio.h>
+
+namespace ed
+{
+	MicroBenchmark::MicroBenchmark(InterfaceManager* iface, const std::string& tempDir)
+	{
+		m_interface = iface;
+		m_tempDir = tempDir;
+		m_samples = 30;
+	}
+	void MicroBenchmark::RunAll()
+	{
+		m_benchProject();
+		m_benchTranscompiler();
+		m_benchAudio();
+		m_benchRay();
+		m_benchModel();
+		m_benchUniforms();
+		m_benchFunctions();
+	}
+	void MicroBenchmark::Run(const std::string& name, const std::function<void()>& func, int opsPerCall)
+	{
+		if (!IsSelected(name))
+			return;
+
+		typedef std::chrono::high_resolution_clock Clock;
+
+		// warm up & find out how many calls are needed so that the timer resolution doesn't matter
+		int iterations = 1;
+		while (true) {
+			auto start = Clock::now();
+			for (int i = 0; i < iterations; i++)
+				func();
+			float elapsed = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+			if (elapsed >= 1.0f || iterations >= (1 << 24))
+				break;
+			iterations *= 2;
+		}
+
+		std::vector<float> samples(m_samples);
+		for (int s = 0; s < m_samples; s++) {
+			auto start = Clock::now();
+			for (int i = 0; i < iterations; i++)
+				func();
+			samples[s] = std::chrono::duration<float, std::micro>(Clock::now() - start).count() / ((float)iterations * opsPerCall);
+		}
+		std::sort(samples.begin(), samples.end());
+
+		Result res;
+		res.Name = name;
+		res.Samples = m_samples;
+		res.Iterations = iterations;
+		res.Min = samples[0];
+		res.Median = samples[samples.size() / 2];
+		res.P95 = samples[std::max(0, std::min<int>((int)std::ceil(0.95f * samples.size()), samples.size()) - 1)];
+		m_results.push_back(res);
+	}
+	bool MicroBenchmark::IsSelected(const std::string& name)
+	{
+		if (m_filter.size() == 0)
+			return true;
+
+		for (const auto& filter : m_filter)
+			if (name.compare(0, filter.size(), filter) == 0)
+				return true;
+
+		return false;
+	}
+	std::string MicroBenchmark::GetReport()
+	{
+		char line[256];
+
+		std::stringstream report;
+		snprintf(line, 256, "%-24s %8s %10s %14s %14s %14s\n", "benchmark", "samples", "iterations", "min (us/op)", "median (us/op)", "p95 (us/op)");
+		report << line;
+
+		for (const auto& res : m_results) {
+			snprintf(line, 256, "%-24s %8d %10d %14.3f %14.3f %14.3f\n", res.Name.c_str(), res.Samples, res.Iterations, res.Min, res.Median, res.P95);
+			report << line;
+		}
+
+		return report.str();
+	}
+	void MicroBenchmark::m_benchProject()
+	{
+		if (!IsSelected("project.open") && !IsSelected("project.save"))
+			return;
+
+		const int passCount = 32;
+		const int varCount = 24;
+
+		std::string dir = m_tempDir + "/project";
+		std::error_code errCode;
+		ghc::filesystem::create_directories(dir + "/shaders", errCode);
+
+		m_writeFile(dir + "/shaders/bench.vs",
+			"#version 330\n"
+			"uniform mat4 matVP;\n"
+			"uniform mat4 matGeo;\n"
+			"layout (location = 0) in vec3 pos;\n"
+			"layout (location = 1) in vec3 normal;\n"
+			"out vec4 color;\n"
+			"void main() {\n"
+			"	color = vec4(abs(normal), 1.0);\n"
+			"	gl_Position = matVP * matGeo * vec4(pos, 1);\n"
+			"}\n");
+		m_writeFile(dir + "/shaders/bench.ps",
+			"#version 330\n"
+			"in vec4 color;\n"
+			"out vec4 outColor;\n"
+			"void main() {\n"
+			"	outColor = color;\n"
+			"}\n");
+
+		// a big project: many passes with many values & functions
+		std::stringstream proj;
+		proj << "<?xml version=\"1.0\"?>\n<project version=\"2\">\n\t<pipeline>\n";
+		for (int i = 0; i < passCount; i++) {
+			proj << "\t\t<pass name=\"Pass" << i << "\">\n";
+			proj << "\t\t\t<shader type=\"vs\" path=\"shaders/bench.vs\" entry=\"main\" />\n";
+			proj << "\t\t\t<shader type=\"ps\" path=\"shaders/bench.ps\" entry=\"main\" />\n";
+			proj << "\t\t\t<rendertexture />\n\t\t\t<variables>\n";
+			proj << "\t\t\t\t<variable type=\"float4x4\" name=\"matVP\" system=\"ViewProjection\" />\n";
+			proj << "\t\t\t\t<variable type=\"float4x4\" name=\"matGeo\" system=\"GeometryTransform\" />\n";
+			for (int j = 0; j < varCount; j++) {
+				if (j % 2 == 0)
+					proj << "\t\t\t\t<variable type=\"float4\" name=\"value" << j << "\"><row><value>0.1</value><value>0.2</value><value>0.3</value><value>1</value></row></variable>\n";
+				else
+					proj << "\t\t\t\t<variable type=\"float4x4\" name=\"rotation" << j << "\" function=\"MatrixRotationY\"><row><value>" << j * 0.1f << "</value></row></variable>\n";
+			}
+			proj << "\t\t\t</variables>\n\t\t\t<items>\n";
+			proj << "\t\t\t\t<item name=\"Box" << i << "\" type=\"geometry\"><type>Cube</type><width>1</width><height>1</height><depth>1</depth><topology>TriangleList</topology></item>\n";
+			proj << "\t\t\t</items>\n\t\t\t<itemvalues />\n\t\t</pass>\n";
+		}
+		proj << "\t</pipeline>\n\t<objects />\n\t<settings>\n\t\t<entry type=\"clearcolor\" r=\"0\" g=\"0\" b=\"0\" a=\"0\" />\n\t</settings>\n</project>\n";
+
+		std::string file = dir + "/bench.sprj";
+		if (!m_writeFile(file, proj.str()))
+			return;
+
+		ProjectParser& parser = m_interface->Parser;
+		RenderEngine& renderer = m_interface->Renderer;
+
+		Run("project.open", [&]() {
+			renderer.FlushCache();
+			parser.Open(file);
+		});
+
+		// project.open might be filtered out
+		if (parser.GetOpenedFile() != file) {
+			renderer.FlushCache();
+			parser.Open(file);
+		}
+
+		Run("project.save", [&]() {
+			parser.Save();
+		});
+	}
+	void MicroBenchmark::m_benchTranscompiler()
+	{
+		if (!IsSelected("transcompile"))
+			return;
+
+		// HLSL pixel shader with a bunch of helper functions
+		std::stringstream hlsl;
+		hlsl << "cbuffer cbPerFrame : register(b0) {\n\tfloat4x4 matVP;\n\tfloat4 color;\n\tfloat time;\n};\n";
+		hlsl << "Texture2D tex : register(t0);\nSamplerState smp : register(s0);\n";
+		hlsl << "struct PSInput {\n\tfloat4 Position : SV_POSITION;\n\tfloat2 UV : TEXCOORD0;\n};\n";
+		for (int i = 0; i < 16; i++)
+			hlsl << "float3 helper" << i << "(float2 uv) {\n\tfloat3 ret = 0;\n\tfor (int i = 0; i < 4; i++)\n\t\tret += sin(time * " << i + 1 << " + i * uv.xyx) * 0.1;\n\treturn ret;\n}\n";
+		hlsl << "float4 main(PSInput pin) : SV_TARGET {\n\tfloat4 ret = tex.Sample(smp, pin.UV) * color;\n";
+		for (int i = 0; i < 16; i++)
+			hlsl << "\tret.rgb += helper" << i << "(pin.UV);\n";
+		hlsl << "\treturn mul(matVP, ret);\n}\n";
+
+		// Vulkan GLSL version of the same shader
+		std::stringstream vk;
+		vk << "#version 450\nlayout(location = 0) in vec2 uv;\nlayout(location = 0) out vec4 outColor;\n";
+		vk << "layout(binding = 0) uniform cbPerFrame {\n\tmat4 matVP;\n\tvec4 color;\n\tfloat time;\n} ubo;\n";
+		vk << "layout(binding = 1) uniform sampler2D tex;\n";
+		for (int i = 0; i < 16; i++)
+			vk << "vec3 helper" << i << "(vec2 uv) {\n\tvec3 ret = vec3(0);\n\tfor (int i = 0; i < 4; i++)\n\t\tret += sin(ubo.time * " << i + 1 << " + i * uv.xyx) * 0.1;\n\treturn ret;\n}\n";
+		vk << "void main() {\n\tvec4 ret = texture(tex, uv) * ubo.color;\n";
+		for (int i = 0; i < 16; i++)
+			vk << "\tret.rgb += helper" << i << "(uv);\n";
+		vk << "\toutColor = ubo.matVP * ret;\n}\n";
+
+		std::string hlslSource = hlsl.str(), vkSource = vk.str();
+		std::vector<ShaderMacro> macros;
+		std::vector<std::string> includeDirs;
+
+		auto transcompile = [&](ShaderLanguage lang, const std::string& file, const std::string& source) -> bool {
+			MessageStack msgs;
+			return ShaderTranscompiler::TranscompileSource(lang, file, source, 1, "main", macros, false, &msgs, includeDirs) != "error";
+		};
+
+		if (transcompile(ShaderLanguage::HLSL, "bench.hlsl", hlslSource))
+			Run("transcompile.hlsl", [&]() { transcompile(ShaderLanguage::HLSL, "bench.hlsl", hlslSource); });
+		else
+			printf("transcompile.hlsl: failed to transcompile the shader\n");
+
+		if (transcompile(ShaderLanguage::VulkanGLSL, "bench.glsl", vkSource))
+			Run("transcompile.vulkan", [&]() { transcompile(ShaderLanguage::VulkanGLSL, "bench.glsl", vkSource); });
+		else
+			printf("transcompile.vulkan: failed to transcompile the shader\n");
+	}
+	void MicroBenchmark::m_benchAudio()
+	{
+		if (!IsSelected("audio.fft"))
+			return;
+
+		// 4 seconds of stereo noise + a few tones
+		const int rate = 44100;
+		const int length = rate * 4;
+
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<int> noise(-2000, 2000);
+
+		std::vector<sf::Int16> samples(length * 2);
+		for (int i = 0; i < length; i++) {
+			float t = i / (float)rate;
+			float tone = sin(t * 440.0f * 6.2831853f) + 0.5f * sin(t * 1250.0f * 6.2831853f) + 0.25f * sin(t * 80.0f * 6.2831853f);
+			samples[i * 2 + 0] = (sf::Int16)(tone * 8000.0f) + noise(gen);
+			samples[i * 2 + 1] = (sf::Int16)(tone * 8000.0f) + noise(gen);
+		}
+
+		sf::SoundBuffer buffer;
+		if (!buffer.loadFromSamples(samples.data(), samples.size(), 2, rate))
+			return;
+
+		AudioAnalyzer analyzer;
+		int curSample = 0;
+		Run("audio.fft", [&]() {
+			analyzer.FFT(buffer, curSample);
+			curSample = (curSample + rate / 60) % (length - AudioAnalyzer::SampleCount);
+		});
+	}
+	void MicroBenchmark::m_benchRay()
+	{
+		if (!IsSelected("ray"))
+			return;
+
+		const int count = 4096;
+
+		std::mt19937 gen(42);
+		std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+		std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+		auto randVec = [&]() -> glm::vec3 { return glm::vec3(pos(gen), pos(gen), pos(gen)); };
+
+		std::vector<glm::vec3> origins(count), dirs(count), tris(count * 3), boxes(count * 2);
+		for (int i = 0; i < count; i++) {
+			origins[i] = randVec();
+
+			// half of the rays are aimed at the primitives
+			glm::vec3 target = (i % 2 == 0) ? glm::vec3(0.0f) : randVec();
+			dirs[i] = glm::normalize(target - origins[i] + glm::vec3(0.001f));
+
+			glm::vec3 center = randVec() * 0.25f;
+			tris[i * 3 + 0] = center + glm::vec3(-size(gen), -size(gen), 0.0f);
+			tris[i * 3 + 1] = center + glm::vec3(size(gen), -size(gen), 0.0f);
+			tris[i * 3 + 2] = center + glm::vec3(0.0f, size(gen), size(gen));
+
+			glm::vec3 extent(size(gen), size(gen), size(gen));
+			boxes[i * 2 + 0] = center - extent;
+			boxes[i * 2 + 1] = center + extent;
+		}
+
+		int hits = 0;
+		Run("ray.triangle", [&]() {
+			float dist;
+			for (int i = 0; i < count; i++)
+				hits += ray::IntersectTriangle(origins[i], dirs[i], tris[i * 3 + 0], tris[i * 3 + 1], tris[i * 3 + 2], dist);
+		}, count);
+		Run("ray.box", [&]() {
+			float dist;
+			for (int i = 0; i < count; i++)
+				hits += ray::IntersectBox(boxes[i * 2 + 0], boxes[i * 2 + 1], origins[i], dirs[i], dist);
+		}, count);
+
+		if (hits == -1) // keep the results alive
+			printf("\n");
+	}
+	void MicroBenchmark::m_benchModel()
+	{
+		if (!IsSelected("model"))
+			return;
+
+		// grid with 32k triangles
+		const int gridSize = 128;
+
+		std::stringstream obj;
+		for (int y = 0; y <= gridSize; y++)
+			for (int x = 0; x <= gridSize; x++) {
+				float u = x / (float)gridSize, v = y / (float)gridSize;
+				obj << "v " << u * 2.0f - 1.0f << " " << sin(u * 12.0f) * cos(v * 12.0f) * 0.1f << " " << v * 2.0f - 1.0f << "\n";
+				obj << "vt " << u << " " << v << "\n";
+				obj << "vn 0 1 0\n";
+			}
+		for (int y = 0; y < gridSize; y++)
+			for (int x = 0; x < gridSize; x++) {
+				int i0 = y * (gridSize + 1) + x + 1; // OBJ indices start at 1
+				int i1 = i0 + 1;
+				int i2 = i0 + gridSize + 1;
+				int i3 = i2 + 1;
+				obj << "f " << i0 << "/" << i0 << "/" << i0 << " " << i2 << "/" << i2 << "/" << i2 << " " << i1 << "/" << i1 << "/" << i1 << "\n";
+				obj << "f " << i1 << "/" << i1 << "/" << i1 << " " << i2 << "/" << i2 << "/" << i2 << " " << i3 << "/" << i3 << "/" << i3 << "\n";
+			}
+
+		std::string file = m_tempDir + "/grid.obj";
+		if (!m_writeFile(file, obj.str()))
+			return;
+
+		Run("model.load", [&]() {
+			eng::Model model;
+			model.LoadFromFile(file);
+		});
+
+		if (!IsSelected("model.pick"))
+			return;
+
+		eng::Model model;
+		if (!model.LoadFromFile(file))
+			return;
+
+		std::mt19937 gen(42);
+		std::uniform_real_distribution<float> pos(-2.0f, 2.0f);
+
+		const int rayCount = 64;
+		std::vector<glm::vec3> origins(rayCount), dirs(rayCount);
+		for (int i = 0; i < rayCount; i++) {
+			origins[i] = glm::vec3(pos(gen), 3.0f, pos(gen));
+			dirs[i] = glm::normalize(glm::vec3(pos(gen), -3.0f, pos(gen)));
+		}
+
+		// same as RenderEngine::m_pickItem
+		int hits = 0;
+		Run("model.pick", [&]() {
+			for (int r = 0; r < rayCount; r++) {
+				float pickDist = std::numeric_limits<float>::infinity();
+				float myDist = std::numeric_limits<float>::infinity();
+				float triDist = std::numeric_limits<float>::infinity();
+
+				if (ray::IntersectBox(model.GetMinBound(), model.GetMaxBound(), origins[r], dirs[r], triDist)) {
+					bool donetris = false;
+					for (auto& mesh : model.Meshes) {
+						for (int i = 0; i + 2 < mesh.Vertices.size(); i += 3) {
+							glm::vec3 v0 = mesh.Vertices[i + 0].Position;
+							glm::vec3 v1 = mesh.Vertices[i + 1].Position;
+							glm::vec3 v2 = mesh.Vertices[i + 2].Position;
+
+							if (ray::IntersectTriangle(origins[r], dirs[r], v0, v1, v2, triDist))
+								if (triDist < myDist) {
+									myDist = triDist;
+
+									if (triDist < pickDist) {
+										donetris = true;
+										break;
+									}
+								}
+						}
+
+						if (donetris)
+							break;
+					}
+				}
+
+				hits += myDist != std::numeric_limits<float>::infinity();
+			}
+		}, rayCount);
+
+		if (hits == -1) // keep the results alive
+			printf("\n");
+	}
+	void MicroBenchmark::m_benchUniforms()
+	{
+		if (!IsSelected("uniforms.bind"))
+			return;
+
+		// shader with a bit of everything: scalars, vectors, matrices, integers & system variables
+		const int uniformCount = 32;
+		static const char* glslTypes[] = { "float", "vec2", "vec4", "mat4", "ivec2" };
+		static const ShaderVariable::ValueType varTypes[] = { ShaderVariable::ValueType::Float1, ShaderVariable::ValueType::Float2, ShaderVariable::ValueType::Float4, ShaderVariable::ValueType::Float4x4, ShaderVariable::ValueType::Integer2 };
+		static const char* glslUsage[] = { "sum.x += u%d;\n", "sum.xy += u%d;\n", "sum += u%d;\n", "sum += u%d[0];\n", "sum.xy += vec2(u%d);\n" };
+
+		std::string ps = "#version 330\nout vec4 outColor;\n";
+		std::string psMain = "void main() {\n\tvec4 sum = vec4(0.0);\n";
+		for (int i = 0; i < uniformCount; i++) {
+			char usage[64];
+			snprintf(usage, 64, glslUsage[i % 5], i);
+
+			ps += "uniform " + std::string(glslTypes[i % 5]) + " u" + std::to_string(i) + ";\n";
+			psMain += "\t" + std::string(usage);
+		}
+		ps += psMain + "\toutColor = sum;\n}\n";
+
+		const char* vs = "#version 330\nlayout (location = 0) in vec3 pos;\nvoid main() {\n\tgl_Position = vec4(pos, 1.0);\n}\n";
+
+		GLchar msg[1024];
+		GLuint vShader = gl::CompileShader(GL_VERTEX_SHADER, vs);
+		GLuint pShader = gl::CompileShader(GL_FRAGMENT_SHADER, ps.c_str());
+		GLuint prog = glCreateProgram();
+		glAttachShader(prog, vShader);
+		glAttachShader(prog, pShader);
+		glLinkProgram(prog);
+		glDeleteShader(vShader);
+		glDeleteShader(pShader);
+
+		if (!gl::CheckShaderLinkStatus(prog, msg)) {
+			printf("uniforms.bind: failed to link the program: %s\n", msg);
+			glDeleteProgram(prog);
+			return;
+		}
+
+		ShaderVariableContainer vars;
+		for (int i = 0; i < uniformCount; i++) {
+			std::string name = "u" + std::to_string(i);
+			SystemShaderVariable system = SystemShaderVariable::None;
+			if (i == 0)
+				system = SystemShaderVariable::Time;
+			else if (i == 3)
+				system = SystemShaderVariable::ViewProjection;
+
+			ShaderVariable* var = new ShaderVariable(varTypes[i % 5], name.c_str(), system);
+			FunctionVariableManager::AllocateArgumentSpace(var, FunctionShaderVariable::None);
+			if (i == 8) { // a function variable too
+				FunctionVariableManager::AllocateArgumentSpace(var, FunctionShaderVariable::MatrixRotationY);
+				*FunctionVariableManager::LoadFloat(var->Arguments, 0) = 0.5f;
+			}
+			vars.Add(var);
+		}
+		vars.UpdateUniformInfo(prog);
+
+		glUseProgram(prog);
+		Run("uniforms.bind", [&]() {
+			FunctionVariableManager::ClearVariableList();
+			vars.Bind();
+		});
+		glUseProgram(0);
+
+		glDeleteProgram(prog);
+	}
+	void MicroBenchmark::m_benchFunctions()
+	{
+		if (!IsSelected("functions.update"))
+			return;
+
+		static const FunctionShaderVariable funcs[] = {
+			FunctionShaderVariable::MatrixPerspectiveFovLH,
+			FunctionShaderVariable::MatrixLookAtLH,
+			FunctionShaderVariable::MatrixRotationRollPitchYaw,
+			FunctionShaderVariable::MatrixTranslation,
+			FunctionShaderVariable::MatrixScaling,
+			FunctionShaderVariable::ScalarSin,
+			FunctionShaderVariable::VectorNormalize,
+			FunctionShaderVariable::Pointer
+		};
+		const int funcCount = sizeof(funcs) / sizeof(funcs[0]);
+		const int varCount = 64;
+
+		ShaderVariableContainer vars;
+		for (int i = 0; i < varCount; i++) {
+			FunctionShaderVariable func = funcs[i % funcCount];
+
+			ShaderVariable::ValueType type = ShaderVariable::ValueType::Float4x4;
+			if (func == FunctionShaderVariable::ScalarSin)
+				type = ShaderVariable::ValueType::Float1;
+			else if (func == FunctionShaderVariable::VectorNormalize)
+				type = ShaderVariable::ValueType::Float4;
+
+			std::string name = "f" + std::to_string(i);
+			ShaderVariable* var = new ShaderVariable(type, name.c_str());
+			FunctionVariableManager::AllocateArgumentSpace(var, func);
+
+			if (func == FunctionShaderVariable::Pointer)
+				strcpy(var->Arguments, "f0");
+			else
+				for (int a = 0; a < FunctionVariableManager::GetArgumentCount(func); a++)
+					*FunctionVariableManager::LoadFloat(var->Arguments, a) = (a + 1) * 0.25f;
+
+			vars.Add(var);
+		}
+
+		// the first run also builds the dependency graph
+		std::vector<const ShaderVariableContainer*> containers = { &vars };
+		FunctionVariableManager::ClearVariableList();
+
+		Run("functions.update", [&]() {
+			FunctionVariableManager::Evaluate(containers);
+		}, varCount);
+
+		FunctionVariableManager::ClearVariableList();
+	}
+	bool MicroBenchmark::m_writeFile(const std::string& file, const std::string& data)
+	{
+		std::ofstream out(file);
+		if (!out.is_open()) {
+			printf("Failed to write %s\n", file.c_str());
+			return false;
+		}
+		out << data;
+		return true;
+	}
+}
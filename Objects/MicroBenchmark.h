@@ -0,0 +1,56 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ed
+{
+	class InterfaceManager;
+
+	// measures the CPU side hot paths of the engine in isolation on synthetic inputs - used by the --microbench mode
+	class MicroBenchmark
+	{
+	public:
+		struct Result
+		{
+			std::string Name;
+			int Samples;
+			int Iterations;		// number of calls in each sample
+			float Min, Median, P95; // microseconds per operation
+		};
+
+		MicroBenchmark(InterfaceManager* iface, const std::string& tempDir);
+
+		inline void SetFilter(const std::vector<std::string>& filter) { m_filter = filter; }
+		inline void SetSampleCount(int samples) { m_samples = samples; }
+
+		// run all the (selected) benchmarks
+		void RunAll();
+
+		// run func in batches that take at least ~1ms, opsPerCall == number of operations done in one func call
+		void Run(const std::string& name, const std::function<void()>& func, int opsPerCall = 1);
+		bool IsSelected(const std::string& name);
+
+		inline const std::vector<Result>& GetResults() { return m_results; }
+		std::string GetReport();
+
+	private:
+		void m_benchProject();
+		void m_benchTranscompiler();
+		void m_benchAudio();
+		void m_benchRay();
+		void m_benchModel();
+		void m_benchUniforms();
+		void m_benchFunctions();
+
+		bool m_writeFile(const std::string& file, const std::string& data);
+
+		InterfaceManager* m_interface;
+		std::string m_tempDir;
+
+		std::vector<std::string> m_filter;
+		int m_samples;
+
+		std::vector<Result> m_results;
+	};
+}
@@ -49,7 +49,8 @@ const char* SYSTEM_VARIABLE_NAMES[] = {
 	"KeysWASD",
 	"Mouse",
 	"MouseButton",
-	"PluginVariable"
+	"PluginVariable",
+	"PassSlice"
 };
 const char* VARIABLE_TYPE_NAMES[] = {
 	"bool",
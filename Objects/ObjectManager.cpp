@@ -6,16 +6,20 @@
 
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
+#include "../Engine/GLCallCounterHooks.h"
+
 namespace ed
 {
 	ObjectManager::ObjectManager(ProjectParser* parser, RenderEngine* rnd) :
 		m_parser(parser), m_renderer(rnd)
 	{
 		m_binds.clear();
+		m_bindVersion = 1;
 	}
 	ObjectManager::~ObjectManager()
 	{
@@ -70,11 +74,44 @@ namespace ed
 			delete m_itemData[i];
 		}
 		
+		m_itemsByName.clear();
+		m_itemsByTexture.clear();
+		m_itemsByBuffer.clear();
+		m_itemsByPlugin.clear();
 		m_binds.clear();
 		m_uniformBinds.clear();
+		m_bindTables.clear();
+		m_bindVersion++;
 		m_items.clear();
 		m_itemData.clear();
 	}
+	void ObjectManager::m_addItem(const std::string& name, ObjectManagerItem* item)
+	{
+		item->Name = name;
+
+		m_itemData.push_back(item);
+		m_items.push_back(name);
+		m_bindVersion++;
+
+		m_itemsByName[name] = item;
+		if (item->Texture != 0)
+			m_itemsByTexture[item->Texture] = item;
+		if (item->Image != nullptr)
+			m_itemsByTexture[item->Image->Texture] = item;
+		if (item->Image3D != nullptr)
+			m_itemsByTexture[item->Image3D->Texture] = item;
+		if (item->Buffer != nullptr)
+			m_itemsByBuffer[item->Buffer->ID] = item;
+		if (item->Plugin != nullptr)
+			m_itemsByPlugin[item->Plugin->ID] = item;
+	}
+	ObjectManagerItem* ObjectManager::m_getItemByTexture(GLuint id)
+	{
+		auto it = m_itemsByTexture.find(id);
+		if (it != m_itemsByTexture.end())
+			return it->second;
+		return nullptr;
+	}
 	bool ObjectManager::CreateRenderTexture(const std::string & name)
 	{
 		Logger::Get().Log("Creating a render texture " + name + " ...");
@@ -87,8 +124,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(name);
 
 		ed::RenderTextureObject* rtObj = item->RT = new ed::RenderTextureObject();
 		glm::ivec2 size = m_renderer->GetLastRenderSize();
@@ -127,6 +162,8 @@ namespace ed
 		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Settings::Instance().Preview.MSAA, GL_DEPTH24_STENCIL8, size.x, size.y, true);
 		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
 
+		m_addItem(name, item);
+
 		return true;
 	}
 	bool ObjectManager::CreateTexture(const std::string& file)
@@ -149,8 +186,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(file);
 
 		item->IsTexture = true;
 
@@ -228,6 +263,8 @@ namespace ed
 
 		stbi_image_free(data);
 
+		m_addItem(file, item);
+
 		return true;
 	}
 	bool ObjectManager::CreateCubemap(const std::string& name, const std::string& left, const std::string& top, const std::string& front, const std::string& bottom, const std::string& right, const std::string& back)
@@ -242,8 +279,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(name);
 
 		item->IsCube = true;
 
@@ -286,6 +321,8 @@ namespace ed
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 		item->ImageSize = glm::ivec2(width, height);
 
+		m_addItem(name, item);
+
 		return true;
 	}
 	bool ObjectManager::CreateAudio(const std::string& file)
@@ -307,9 +344,7 @@ namespace ed
 			return false;
 		}
 
-		m_itemData.push_back(item);
 		m_parser->ModifyProject();
-		m_items.push_back(file);
 
 		glGenTextures(1, &item->Texture);
 		glBindTexture(GL_TEXTURE_2D, item->Texture);
@@ -326,6 +361,8 @@ namespace ed
 		item->Sound->play();
 		item->SoundMuted = false;
 
+		m_addItem(file, item);
+
 		return true;
 	}
 	bool ObjectManager::CreateBuffer(const std::string& name)
@@ -340,8 +377,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(name);
 
 		ed::BufferObject* bObj = item->Buffer = new ed::BufferObject();
 		glm::ivec2 size = m_renderer->GetLastRenderSize();
@@ -355,6 +390,8 @@ namespace ed
 		glBufferData(GL_UNIFORM_BUFFER, 0, NULL, GL_STATIC_DRAW); // allocate 0 bytes of memory
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+		m_addItem(name, item);
+
 		return true;
 	}
 	bool ObjectManager::CreateImage(const std::string& name, glm::ivec2 size)
@@ -369,8 +406,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(name);
 
 		ed::ImageObject* iObj = item->Image = new ImageObject();
 
@@ -384,6 +419,8 @@ namespace ed
 		iObj->Size = size;
 		iObj->Format = GL_RGBA32F;
 
+		m_addItem(name, item);
+
 		return true;
 	}
 	bool ObjectManager::CreateImage3D(const std::string& name, glm::ivec3 size)
@@ -398,8 +435,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(name);
 
 		ed::Image3DObject* iObj = item->Image3D = new Image3DObject();
 		iObj->Size = size;
@@ -412,6 +447,8 @@ namespace ed
 		glTexImage3D(GL_TEXTURE_3D, 0, iObj->Format, size.x, size.y, size.z, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
 		glBindTexture(GL_TEXTURE_3D, 0);
 
+		m_addItem(name, item);
+
 		return true;
 	}
 	bool ObjectManager::CreatePluginItem(const std::string& name, const std::string& objtype, void* data, GLuint id, IPlugin* owner)
@@ -426,8 +463,6 @@ namespace ed
 		m_parser->ModifyProject();
 
 		ObjectManagerItem* item = new ObjectManagerItem();
-		m_itemData.push_back(item);
-		m_items.push_back(name);
 
 		PluginObject* pObj = item->Plugin = new PluginObject();
 		strcpy(pObj->Type, objtype.c_str());
@@ -435,6 +470,8 @@ namespace ed
 		pObj->Data = data;
 		pObj->ID = id;
 		
+		m_addItem(name, item);
+
 		return true;
 	}
 
@@ -554,18 +591,30 @@ namespace ed
 					j--;
 				}
 		
-		int index = 0;
-		for (; index < m_items.size(); index++)
-			if (m_items[index] == file) break;
+		ObjectManagerItem* item = GetObjectManagerItem(file);
+		int index = std::find(m_itemData.begin(), m_itemData.end(), item) - m_itemData.begin();
 
 		if (IsPluginObject(file)) {
 			PluginObject* pobj = GetPluginObject(file);
 			pobj->Owner->RemoveObject(file.c_str(), pobj->Type, pobj->Data, pobj->ID);
 		}
 
+		m_itemsByName.erase(file);
+		if (item->Texture != 0)
+			m_itemsByTexture.erase(item->Texture);
+		if (item->Image != nullptr)
+			m_itemsByTexture.erase(item->Image->Texture);
+		if (item->Image3D != nullptr)
+			m_itemsByTexture.erase(item->Image3D->Texture);
+		if (item->Buffer != nullptr)
+			m_itemsByBuffer.erase(item->Buffer->ID);
+		if (item->Plugin != nullptr)
+			m_itemsByPlugin.erase(item->Plugin->ID);
+
 		delete m_itemData[index];
 		m_itemData.erase(m_itemData.begin() + index);
 		m_items.erase(m_items.begin() + index);
+		m_bindVersion++;
 	}
 
 	void ObjectManager::Bind(const std::string & file, PipelineItem * pass)
@@ -687,19 +736,74 @@ namespace ed
 		return -1;
 	}
 
-	std::string ObjectManager::GetItemNameByTextureID(GLuint texID)
+	const BindTable& ObjectManager::GetBindTable(PipelineItem* pass)
 	{
-		for (int i = 0; i < m_itemData.size(); i++) {
-			ObjectManagerItem* item = m_itemData[i];
-			if (item->Texture == texID ||
-				(item->Image != nullptr && item->Image->Texture == texID) ||
-				(item->Image3D != nullptr && item->Image3D->Texture == texID) ||
-				(item->Buffer != nullptr && item->Buffer->ID == texID))
-			{
-				return m_items[i];
+		BindTable& table = m_bindTables[pass];
+		const std::vector<GLuint>& srvs = GetBindList(pass);
+		const std::vector<GLuint>& ubos = GetUniformBindList(pass);
+
+		// the lists can also be reordered through GetBindList() so compare them too
+		if (table.Version == m_bindVersion && table.TextureIDs == srvs && table.BufferIDs == ubos)
+			return table;
+
+		table.Version = m_bindVersion;
+		table.TextureIDs = srvs;
+		table.BufferIDs = ubos;
+
+		table.Textures.resize(srvs.size());
+		for (int i = 0; i < srvs.size(); i++) {
+			ResourceBind& bind = table.Textures[i];
+			bind.ID = srvs[i];
+			bind.Format = 0;
+			bind.Plugin = nullptr;
+
+			ObjectManagerItem* item = m_getItemByTexture(srvs[i]);
+			bind.Dynamic = item != nullptr && item->SoundBuffer != nullptr;
+
+			if (IsCubeMap(srvs[i]))
+				bind.Target = GL_TEXTURE_CUBE_MAP;
+			else if (IsImage3D(srvs[i]))
+				bind.Target = GL_TEXTURE_3D;
+			else {
+				bind.Target = GL_TEXTURE_2D;
+				bind.Plugin = GetPluginObject(srvs[i]);
 			}
 		}
 
+		table.Buffers.resize(ubos.size());
+		for (int i = 0; i < ubos.size(); i++) {
+			ResourceBind& bind = table.Buffers[i];
+			bind.ID = ubos[i];
+			bind.Target = 0;
+			bind.Format = 0;
+			bind.Plugin = nullptr;
+			bind.Dynamic = false;
+
+			if (IsImage(ubos[i])) {
+				bind.Target = GL_TEXTURE_2D;
+				bind.Format = GetImage(GetImageNameByID(ubos[i]))->Format;
+			} else if (IsImage3D(ubos[i])) {
+				bind.Target = GL_TEXTURE_3D;
+				bind.Format = GetImage3D(GetImage3DNameByID(ubos[i]))->Format;
+			} else if (IsPluginObject(ubos[i]))
+				bind.Plugin = GetPluginObject(ubos[i]);
+			else if (IsBuffer(GetBufferNameByID(ubos[i])))
+				bind.Target = GL_SHADER_STORAGE_BUFFER;
+		}
+
+		return table;
+	}
+
+	std::string ObjectManager::GetItemNameByTextureID(GLuint texID)
+	{
+		ObjectManagerItem* item = m_getItemByTexture(texID);
+		if (item != nullptr)
+			return item->Name;
+
+		auto buf = m_itemsByBuffer.find(texID);
+		if (buf != m_itemsByBuffer.end())
+			return buf->second->Name;
+
 		return "";
 	}
 	glm::ivec2 ObjectManager::GetRenderTextureSize(const std::string & name)
@@ -710,251 +814,243 @@ namespace ed
 	}
 	const std::vector<std::string>& ObjectManager::GetCubemapTextures(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->CubemapPaths;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->CubemapPaths;
 		return m_emptyCBTexs;
 	}
 
 	bool ObjectManager::IsRenderTexture(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->RT != nullptr;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->RT != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsCubeMap(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->IsCube;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->IsCube;
 		return false;
 	}
 	bool ObjectManager::IsAudio(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Sound != nullptr;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Sound != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsAudioMuted(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->SoundMuted;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->SoundMuted;
 		return false;
 	}
 	bool ObjectManager::IsBuffer(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Buffer != nullptr;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Buffer != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsImage(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Image != nullptr;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Image != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsImage3D(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Image3D != nullptr;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Image3D != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsPluginObject(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Plugin != nullptr;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Plugin != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsPluginObject(GLuint id)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_itemData[i]->Plugin != nullptr && m_itemData[i]->Plugin->ID == id)
-				return true;
-		return false;
+		return m_itemsByPlugin.count(id) > 0;
 	}
 	bool ObjectManager::IsCubeMap(GLuint id)
 	{
-		for (const auto& i : m_itemData)
-			if (i->Texture == id)
-				return i->IsCube;
+		ObjectManagerItem* item = m_getItemByTexture(id);
+		if (item != nullptr)
+			return item->IsCube;
 		return false;
 	}
 	bool ObjectManager::IsImage(GLuint id)
 	{
-		for (const auto& i : m_itemData)
-			if (i->Image != nullptr && i->Image->Texture == id)
-				return true;
+		ObjectManagerItem* item = m_getItemByTexture(id);
+		if (item != nullptr)
+			return item->Image != nullptr;
 		return false;
 	}
 	bool ObjectManager::IsImage3D(GLuint id)
 	{
-		for (const auto& i : m_itemData)
-			if (i->Image3D != nullptr && i->Image3D->Texture == id)
-				return true;
+		ObjectManagerItem* item = m_getItemByTexture(id);
+		if (item != nullptr)
+			return item->Image3D != nullptr;
 		return false;
 	}
 
 	GLuint ObjectManager::GetTexture(const std::string& file)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == file)
-				return m_itemData[i]->Texture;
+		ObjectManagerItem* item = GetObjectManagerItem(file);
+		if (item != nullptr)
+			return item->Texture;
 		return 0;
 	}
 	GLuint ObjectManager::GetFlippedTexture(const std::string& file)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == file)
-				return m_itemData[i]->FlippedTexture;
+		ObjectManagerItem* item = GetObjectManagerItem(file);
+		if (item != nullptr)
+			return item->FlippedTexture;
 		return 0;
 	}
 	glm::ivec2 ObjectManager::GetTextureSize(const std::string& file)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == file)
-				return m_itemData[i]->ImageSize;
+		ObjectManagerItem* item = GetObjectManagerItem(file);
+		if (item != nullptr)
+			return item->ImageSize;
 		return glm::ivec2(0,0);
 	}
 	sf::SoundBuffer* ObjectManager::GetSoundBuffer(const std::string& file)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == file)
-				return m_itemData[i]->SoundBuffer;
+		ObjectManagerItem* item = GetObjectManagerItem(file);
+		if (item != nullptr)
+			return item->SoundBuffer;
 		return nullptr;
 	}
 	sf::Sound* ObjectManager::GetAudioPlayer(const std::string& file)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == file)
-				return m_itemData[i]->Sound;
+		ObjectManagerItem* item = GetObjectManagerItem(file);
+		if (item != nullptr)
+			return item->Sound;
 		return nullptr;
 	}
 	BufferObject* ObjectManager::GetBuffer(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Buffer;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Buffer;
 		return nullptr;
 	}
 	ImageObject* ObjectManager::GetImage(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Image;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Image;
 		return nullptr;
 	}
 	Image3DObject* ObjectManager::GetImage3D(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Image3D;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Image3D;
 		return nullptr;
 	}
 	glm::ivec2 ObjectManager::GetImageSize(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Image->Size;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Image->Size;
 		return glm::ivec2(0,0);
 	}
 	glm::ivec3 ObjectManager::GetImage3DSize(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Image3D->Size;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Image3D->Size;
 		return glm::ivec3(0, 0, 0);
 	}
 	RenderTextureObject* ObjectManager::GetRenderTexture(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->RT;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->RT;
 		return nullptr;
 	}
 	PluginObject* ObjectManager::GetPluginObject(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i]->Plugin;
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr)
+			return item->Plugin;
 		return nullptr;
 	}
 	PluginObject* ObjectManager::GetPluginObject(GLuint id)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_itemData[i]->Plugin != nullptr && m_itemData[i]->Plugin->ID == id)
-				return m_itemData[i]->Plugin;
+		auto it = m_itemsByPlugin.find(id);
+		if (it != m_itemsByPlugin.end())
+			return it->second->Plugin;
 		return nullptr;
 	}
 
 	RenderTextureObject* ObjectManager::GetRenderTexture(GLuint tex)
 	{
-		for (const auto& i : m_itemData)
-			if (i->Texture == tex)
-				return i->RT;
+		ObjectManagerItem* item = m_getItemByTexture(tex);
+		if (item != nullptr)
+			return item->RT;
 		return nullptr;
 	}
 	std::string ObjectManager::GetBufferNameByID(int id)
 	{
-		for (int i = 0; i < m_itemData.size(); i++)
-			if (m_itemData[i]->Buffer != nullptr && m_itemData[i]->Buffer->ID == id)
-				return m_items[i];
+		auto it = m_itemsByBuffer.find(id);
+		if (it != m_itemsByBuffer.end())
+			return it->second->Name;
 		return "";
 	}
 	std::string ObjectManager::GetImageNameByID(GLuint id)
 	{
-		for (int i = 0; i < m_itemData.size(); i++)
-			if (m_itemData[i]->Image != nullptr && m_itemData[i]->Image->Texture == id)
-				return m_items[i];
+		ObjectManagerItem* item = m_getItemByTexture(id);
+		if (item != nullptr && item->Image != nullptr)
+			return item->Name;
 		return "";
 	}
 	std::string ObjectManager::GetImage3DNameByID(GLuint id)
 	{
-		for (int i = 0; i < m_itemData.size(); i++)
-			if (m_itemData[i]->Image3D != nullptr && m_itemData[i]->Image3D->Texture == id)
-				return m_items[i];
+		ObjectManagerItem* item = m_getItemByTexture(id);
+		if (item != nullptr && item->Image3D != nullptr)
+			return item->Name;
 		return "";
 	}
 
 	ObjectManagerItem* ObjectManager::GetObjectManagerItem(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++)
-			if (m_items[i] == name)
-				return m_itemData[i];
+		auto it = m_itemsByName.find(name);
+		if (it != m_itemsByName.end())
+			return it->second;
 		return nullptr;
 	}
 	std::string ObjectManager::GetObjectManagerItemName(ObjectManagerItem* item)
 	{
-		for (int i = 0; i < m_itemData.size(); i++)
-			if (m_itemData[i] == item)
-				return m_items[i];
+		if (item != nullptr)
+			return item->Name;
 		return "";
 	}
 
 	void ObjectManager::Mute(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++) {
-			if (m_items[i] == name) {
-				m_itemData[i]->SoundMuted = true;
-				m_itemData[i]->Sound->setVolume(0);
-				break;
-			}
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr) {
+			item->SoundMuted = true;
+			item->Sound->setVolume(0);
 		}
 	}
 	void ObjectManager::Unmute(const std::string& name)
 	{
-		for (int i = 0; i < m_items.size(); i++) {
-			if (m_items[i] == name) {
-				m_itemData[i]->SoundMuted = false;
-				m_itemData[i]->Sound->setVolume(100);
-				break;
-			}
+		ObjectManagerItem* item = GetObjectManagerItem(name);
+		if (item != nullptr) {
+			item->SoundMuted = false;
+			item->Sound->setVolume(100);
 		}
 	}
 
@@ -968,15 +1064,18 @@ namespace ed
 		glBindTexture(GL_TEXTURE_2D, GetTexture(name));
 		glTexImage2D(GL_TEXTURE_2D, 0, rtObj->Format, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
 
+		// transient render textures use the RenderTexturePool's buffers
+		glm::ivec2 bufferSize = rtObj->Transient ? glm::ivec2(1, 1) : size;
+
 		glBindTexture(GL_TEXTURE_2D, rtObj->DepthStencilBuffer);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, size.x, size.y, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, bufferSize.x, bufferSize.y, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
 		glBindTexture(GL_TEXTURE_2D, 0);
 
 		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, rtObj->BufferMS);
-		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Settings::Instance().Preview.MSAA, rtObj->Format, size.x, size.y, true);
+		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Settings::Instance().Preview.MSAA, rtObj->Format, bufferSize.x, bufferSize.y, true);
 
 		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, rtObj->DepthStencilBufferMS);
-		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Settings::Instance().Preview.MSAA, GL_DEPTH24_STENCIL8, size.x, size.y, true);
+		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Settings::Instance().Preview.MSAA, GL_DEPTH24_STENCIL8, bufferSize.x, bufferSize.y, true);
 		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
 	}
 	void ObjectManager::ResizeImage(const std::string& name, glm::ivec2 size)
@@ -984,6 +1083,7 @@ namespace ed
 		ImageObject* iobj = GetImage(name);
 
 		m_parser->ModifyProject();
+		m_bindVersion++; // format might have changed
 
 		iobj->Size = size;
 
@@ -996,6 +1096,7 @@ namespace ed
 		Image3DObject* iobj = GetImage3D(name);
 
 		m_parser->ModifyProject();
+		m_bindVersion++; // format might have changed
 
 		iobj->Size = size;
 
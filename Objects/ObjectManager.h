@@ -24,9 +24,10 @@ namespace ed
 		std::string Name;
 		bool Clear;
 		GLuint Format;
+		bool Transient; // depth-stencil & multisampled buffers are shared with other transient RTs (RenderTexturePool)
 
 		RenderTextureObject() : FixedSize(-1, -1), RatioSize(1,1),
-		Clear(true), ClearColor(0,0,0,1), Format(GL_RGBA) { }
+		Clear(true), ClearColor(0,0,0,1), Format(GL_RGBA), Transient(false) { }
 
 		glm::ivec2 CalculateSize(int w, int h)
 		{
@@ -71,6 +72,28 @@ namespace ed
 		void* Data;
 	};
 
+	// resource bound to a pass, resolved when the bind lists or the objects change
+	struct ResourceBind
+	{
+		GLuint ID;
+		GLenum Target;			// texture target, GL_SHADER_STORAGE_BUFFER for buffers, 0 if unknown
+		GLuint Format;			// only set for images
+		PluginObject* Plugin;
+		bool Dynamic;			// contents change every frame (audio)
+	};
+
+	struct BindTable
+	{
+		std::vector<ResourceBind> Textures;	// GetBindList()
+		std::vector<ResourceBind> Buffers;	// GetUniformBindList()
+
+		// lists that the table was built from
+		std::vector<GLuint> TextureIDs, BufferIDs;
+		unsigned int Version;
+
+		BindTable() : Version(0) { }
+	};
+
 	/* Use this to remove all the maps */
 	class ObjectManagerItem
 	{
@@ -129,6 +152,8 @@ namespace ed
 			CubemapPaths.clear();
 		}
 
+		std::string Name;
+
 		glm::ivec2 ImageSize;
 		GLuint Texture, FlippedTexture;
 		bool IsCube;
@@ -232,7 +257,11 @@ namespace ed
 			return m_emptyResVec;
 		}
 
-		inline bool Exists(const std::string& name) { return std::count(m_items.begin(), m_items.end(), name) > 0; }
+		// precompiled version of the bind lists - rebuilt only when something has changed
+		const BindTable& GetBindTable(PipelineItem* pass);
+		inline void MarkModified() { m_bindVersion++; } // contents of an object were changed outside of the pipeline
+
+		inline bool Exists(const std::string& name) { return m_itemsByName.count(name) > 0; }
 
 		const std::vector<std::string>& GetCubemapTextures(const std::string& name);
 		inline std::vector<ObjectManagerItem*>& GetItemDataList() { return m_itemData; }
@@ -241,9 +270,18 @@ namespace ed
 		RenderEngine* m_renderer;
 		ProjectParser* m_parser;
 
-		std::vector<std::string> m_items; // TODO: move item name to item data
+		std::vector<std::string> m_items; // names in the same order as m_itemData, for GetObjects()
 		std::vector<ObjectManagerItem*> m_itemData; 
 
+		// lookup tables - kept in sync with the lists by m_addItem(), Remove() and Clear()
+		std::unordered_map<std::string, ObjectManagerItem*> m_itemsByName;
+		std::unordered_map<GLuint, ObjectManagerItem*> m_itemsByTexture; // Texture, Image->Texture, Image3D->Texture
+		std::unordered_map<GLuint, ObjectManagerItem*> m_itemsByBuffer;
+		std::unordered_map<GLuint, ObjectManagerItem*> m_itemsByPlugin;
+
+		void m_addItem(const std::string& name, ObjectManagerItem* item);
+		ObjectManagerItem* m_getItemByTexture(GLuint id);
+
 		std::vector<GLuint> m_emptyResVec;
 		std::vector<char> m_emptyResVecChar;
 		std::vector<std::string> m_emptyCBTexs;
@@ -253,5 +291,8 @@ namespace ed
 
 		std::unordered_map<PipelineItem*, std::vector<GLuint>> m_binds;
 		std::unordered_map<PipelineItem*, std::vector<GLuint>> m_uniformBinds;
+
+		unsigned int m_bindVersion; // increased when objects are created, removed or changed
+		std::unordered_map<PipelineItem*, BindTable> m_bindTables;
 	};
 }
\ No newline at end of file
@@ -65,12 +65,21 @@ namespace ed
 				memset(Entry, 0, sizeof(char) * 32);
 
 				WorkX = WorkY = WorkZ = 1;
+				Frozen = false;
+				RunEvery = 1;
+				MaxRate = 0.0f;
+				Slices = 1;
 			}
 
 			char Path[MAX_PATH];
 			char Entry[32];
 
 			GLuint WorkX, WorkY, WorkZ;
+			bool Frozen; // don't execute the pass after it has been executed once
+
+			int RunEvery;	// execute the pass every N frames
+			float MaxRate;	// max number of executions per second, 0 -> no limit
+			int Slices;		// each execution dispatches 1/Slices of the work groups along X (shader adds PassSlice.z to gl_WorkGroupID.x)
 			ShaderVariableContainer Variables;
 			std::vector<ShaderMacro> Macros;
 		};
@@ -97,6 +106,10 @@ namespace ed
 				RTCount = 0;
 				GSUsed = false;
 				Active = true;
+				Frozen = false;
+				RunEvery = 1;
+				MaxRate = 0.0f;
+				Slices = 1;
 				Macros.clear();
 				memset(VSPath, 0, sizeof(char) * MAX_PATH);
 				memset(PSPath, 0, sizeof(char) * MAX_PATH);
@@ -112,6 +125,11 @@ namespace ed
 			GLuint FBO; // actual framebuffer
 
 			bool Active;
+			bool Frozen; // keep the output of the last render
+
+			int RunEvery;	// render the pass every N frames
+			float MaxRate;	// max number of renders per second, 0 -> no limit
+			int Slices;		// each render only covers one of the Slices horizontal strips of the render textures
 
 			char VSPath[MAX_PATH];
 			char VSEntry[32];
@@ -4,24 +4,14 @@
 #include "../Options.h"
 #include "SystemVariableManager.h"
 
-int strcmpcase(const char* s1, const char* s2)
-{
-	const unsigned char* p1 = (const unsigned char*)s1;
-	const unsigned char* p2 = (const unsigned char*)s2;
-	int result;
-	if (p1 == p2)
-		return 0;
-	while ((result = tolower(*p1) - tolower(*p2++)) == 0)
-		if (*p1++ == '\0')
-			break;
-	return result;
-}
+#include <algorithm>
 
 namespace ed
 {
 	PipelineManager::PipelineManager(ProjectParser* project)
 	{
 		m_project = project;
+		m_lastHandle = 0;
 	}
 	PipelineManager::~PipelineManager()
 	{
@@ -32,6 +22,8 @@ namespace ed
 		Logger::Get().Log("Clearing PipelineManager contents");
 
 		for (int i = 0; i < m_items.size(); i++) {
+			m_publish(PipelineEvent::EventType::Remove, m_items[i], nullptr);
+
 			if (m_items[i]->Type == PipelineItem::ItemType::ShaderPass) {
 				// delete pass' child items and their data
 				pipe::ShaderPass* pass = (pipe::ShaderPass*)m_items[i]->Data;
@@ -83,6 +75,8 @@ namespace ed
 			delete m_items[i];
 		}
 		m_items.clear();
+		m_index.clear();
+		m_handles.clear();
 	}
 	bool PipelineManager::AddItem(const char * owner, const char * name, PipelineItem::ItemType type, void * data)
 	{
@@ -104,12 +98,6 @@ namespace ed
 
 		Logger::Get().Log("Adding a pipeline item " + std::string(name) + " to the project");
 
-		for (const auto& item : m_items)
-			if (strcmpcase(item->Name, name) == 0) {
-				Logger::Get().Log("Item " + std::string(name) + " not added - name already taken", true);
-				return false;
-			}
-
 		m_project->ModifyProject();
 
 		for (auto& item : m_items) {
@@ -121,6 +109,7 @@ namespace ed
 
 				pdata->Items.push_back(new PipelineItem("\0", type, data));
 				strcpy(pdata->Items.at(pdata->Items.size() - 1)->Name, name);
+				m_addToIndex(pdata->Items.back(), item);
 
 				pdata->Owner->AddPipelineItemChild(owner, name, (plugin::PipelineItemType)type, data);
 
@@ -129,14 +118,9 @@ namespace ed
 			else if (item->Type == PipelineItem::ItemType::ShaderPass) {
 				pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
 
-				for (auto& i : pass->Items)
-					if (strcmpcase(i->Name, name) == 0) {
-						Logger::Get().Log("Item " + std::string(name) + " not added - name already taken", true);
-						return false;
-					}
-
 				pass->Items.push_back(new PipelineItem("\0", type, data));
 				strcpy(pass->Items.at(pass->Items.size() - 1)->Name, name);
+				m_addToIndex(pass->Items.back(), item);
 
 				Logger::Get().Log("Item " + std::string(name) + " added to the project");
 
@@ -170,6 +154,7 @@ namespace ed
 
 				PipelineItem* pitem = new PipelineItem("\0", PipelineItem::ItemType::PluginItem, pdata);
 				strcpy(pitem->Name, name);
+				m_addToIndex(pitem, item);
 
 				if (item->Type == PipelineItem::ItemType::ShaderPass) {
 					pipe::ShaderPass* pass = (pipe::ShaderPass*)item->Data;
@@ -193,6 +178,7 @@ namespace ed
 			PipelineItem* pitem = new PipelineItem("\0", PipelineItem::ItemType::PluginItem, pdata);
 			m_items.push_back(pitem);
 			strcpy(pitem->Name, name);
+			m_addToIndex(pitem, nullptr);
 
 			return true;
 		}
@@ -212,6 +198,7 @@ namespace ed
 
 		m_items.push_back(new PipelineItem("\0", PipelineItem::ItemType::ShaderPass, data));
 		strcpy(m_items.at(m_items.size() - 1)->Name, name);
+		m_addToIndex(m_items.back(), nullptr);
 
 		return true;
 	}
@@ -228,6 +215,7 @@ namespace ed
 
 		m_items.push_back(new PipelineItem("\0", PipelineItem::ItemType::ComputePass, data));
 		strcpy(m_items.at(m_items.size() - 1)->Name, name);
+		m_addToIndex(m_items.back(), nullptr);
 
 		return true;
 	}
@@ -244,6 +232,7 @@ namespace ed
 
 		m_items.push_back(new PipelineItem("\0", PipelineItem::ItemType::AudioPass, data));
 		strcpy(m_items.at(m_items.size() - 1)->Name, name);
+		m_addToIndex(m_items.back(), nullptr);
 
 		return true;
 	}
@@ -259,6 +248,8 @@ namespace ed
 
 					// TODO: add this part to m_freeShaderPass method
 					for (auto& passItem : data->Items) {
+						m_removeFromIndex(passItem);
+
 						if (passItem->Type == PipelineItem::ItemType::Geometry) {
 							pipe::GeometryItem* geo = (pipe::GeometryItem*)passItem->Data;
 							glDeleteVertexArrays(1, &geo->VAO);
@@ -283,6 +274,8 @@ namespace ed
 					pdata->Owner->RemovePipelineItem(m_items[i]->Name, pdata->Type, pdata->PluginData);
 
 					for (auto& passItem : pdata->Items) {
+						m_removeFromIndex(passItem);
+
 						if (passItem->Type == PipelineItem::ItemType::Geometry) {
 							pipe::GeometryItem* geo = (pipe::GeometryItem*)passItem->Data;
 							glDeleteVertexArrays(1, &geo->VAO);
@@ -299,6 +292,7 @@ namespace ed
 					pdata->Items.clear();
 				}
 
+				m_removeFromIndex(m_items[i]);
 				FreeData(m_items[i]->Data, m_items[i]->Type);
 				m_items[i]->Data = nullptr;
 				m_items.erase(m_items.begin() + i);
@@ -321,6 +315,7 @@ namespace ed
 								pdata->Owner->RemovePipelineItem(data->Items[j]->Name, pdata->Type, pdata->PluginData);
 							}
 
+							m_removeFromIndex(data->Items[j]);
 							FreeData(data->Items[j]->Data, data->Items[j]->Type);
 							data->Items[j]->Data = nullptr;
 							data->Items.erase(data->Items.begin() + j);
@@ -345,6 +340,7 @@ namespace ed
 								pdata->Owner->RemovePipelineItem(data->Items[j]->Name, pdata->Type, pdata->PluginData);
 							}
 
+							m_removeFromIndex(data->Items[j]);
 							FreeData(data->Items[j]->Data, data->Items[j]->Type);
 							data->Items[j]->Data = nullptr;
 							data->Items.erase(data->Items.begin() + j);
@@ -357,55 +353,143 @@ namespace ed
 			
 		m_project->ModifyProject();
 	}
+	bool PipelineManager::Rename(PipelineItem* item, const char* name)
+	{
+		auto it = m_index.find(m_getKey(item->Name));
+		if (it == m_index.end() || it->second.Item != item)
+			return false;
+
+		std::string key = m_getKey(name);
+		if (key != it->first && m_index.count(key) > 0)
+			return false;
+
+		IndexEntry entry = it->second;
+		m_index.erase(it);
+		m_index[key] = entry;
+
+		memcpy(item->Name, name, PIPELINE_ITEM_NAME_LENGTH);
+		m_project->ModifyProject();
+
+		m_publish(PipelineEvent::EventType::Rename, item, entry.Owner);
+
+		return true;
+	}
+	bool PipelineManager::Move(PipelineItem* item, int index)
+	{
+		auto it = m_index.find(m_getKey(item->Name));
+		if (it == m_index.end() || it->second.Item != item)
+			return false;
+
+		PipelineItem* owner = it->second.Owner;
+		std::vector<PipelineItem*>* list = &m_items;
+		if (owner != nullptr && owner->Type == PipelineItem::ItemType::ShaderPass)
+			list = &((pipe::ShaderPass*)owner->Data)->Items;
+		else if (owner != nullptr && owner->Type == PipelineItem::ItemType::PluginItem)
+			list = &((pipe::PluginItemData*)owner->Data)->Items;
+
+		auto pos = std::find(list->begin(), list->end(), item);
+		if (pos == list->end() || index < 0 || index >= list->size())
+			return false;
+
+		list->erase(pos);
+		list->insert(list->begin() + index, item);
+
+		m_project->ModifyProject();
+
+		m_publish(PipelineEvent::EventType::Move, item, owner);
+
+		return true;
+	}
+	void PipelineManager::PollEvents(std::vector<PipelineEvent>& events)
+	{
+		events.clear();
+		events.swap(m_events);
+	}
+	void PipelineManager::m_publish(PipelineEvent::EventType type, PipelineItem* item, PipelineItem* owner)
+	{
+		PipelineEvent e;
+		e.Type = type;
+		e.Item = item;
+		e.Data = item->Data;
+		e.Owner = owner;
+		m_events.push_back(e);
+	}
 	bool PipelineManager::Has(const char * name)
 	{
-		for (int i = 0; i < m_items.size(); i++) {
-			if (strcmpcase(m_items[i]->Name, name) == 0)
-				return true;
-			else {
-				if (m_items[i]->Type == PipelineItem::ItemType::ShaderPass) {
-					pipe::ShaderPass* data = (pipe::ShaderPass*)m_items[i]->Data;
-					for (int j = 0; j < data->Items.size(); j++)
-						if (strcmpcase(data->Items[j]->Name, name) == 0)
-							return true;
-				} else if (m_items[i]->Type == PipelineItem::ItemType::PluginItem) {
-					pipe::PluginItemData* data = (pipe::PluginItemData*)m_items[i]->Data;
-					for (int j = 0; j < data->Items.size(); j++)
-						if (strcmpcase(data->Items[j]->Name, name) == 0)
-							return true;
-				}
-			}
-		}
-		return false;
+		return m_index.count(m_getKey(name)) > 0;
 	}
 	char* PipelineManager::GetItemOwner(const char* name)
 	{
-		for (int i = 0; i < m_items.size(); i++) {
-			if (m_items[i]->Type == PipelineItem::ItemType::ShaderPass) {
-				pipe::ShaderPass* data = (pipe::ShaderPass*)m_items[i]->Data;
-				for (int j = 0; j < data->Items.size(); j++)
-					if (strcmp(data->Items[j]->Name, name) == 0)
-						return m_items[i]->Name;
-			}
-		}
+		auto it = m_index.find(m_getKey(name));
+		if (it == m_index.end() || strcmp(it->second.Item->Name, name) != 0)
+			return nullptr;
+
+		PipelineItem* owner = it->second.Owner;
+		if (owner != nullptr && owner->Type == PipelineItem::ItemType::ShaderPass)
+			return owner->Name;
 		return nullptr;
 	}
 	PipelineItem* PipelineManager::Get(const char* name)
 	{
-		for (int i = 0; i < m_items.size(); i++) {
-			if (strcmp(m_items[i]->Name, name) == 0)
-				return m_items[i];
-			else {
-				if (m_items[i]->Type == PipelineItem::ItemType::ShaderPass) {
-					pipe::ShaderPass* data = (pipe::ShaderPass*)m_items[i]->Data;
-					for (int j = 0; j < data->Items.size(); j++)
-						if (strcmp(data->Items[j]->Name, name) == 0)
-							return data->Items[j];
-				}
-			}
-		}
+		auto it = m_index.find(m_getKey(name));
+		if (it == m_index.end() || strcmp(it->second.Item->Name, name) != 0)
+			return nullptr;
+
+		// children of the plugin items aren't returned
+		PipelineItem* owner = it->second.Owner;
+		if (owner != nullptr && owner->Type != PipelineItem::ItemType::ShaderPass)
+			return nullptr;
+		return it->second.Item;
+	}
+	int PipelineManager::GetHandle(PipelineItem* item)
+	{
+		if (item == nullptr)
+			return 0;
+
+		auto it = m_index.find(m_getKey(item->Name));
+		if (it != m_index.end() && it->second.Item == item)
+			return it->second.Handle;
+		return 0;
+	}
+	PipelineItem* PipelineManager::GetByHandle(int handle)
+	{
+		auto it = m_handles.find(handle);
+		if (it != m_handles.end())
+			return it->second;
 		return nullptr;
 	}
+	std::string PipelineManager::m_getKey(const char* name)
+	{
+		std::string ret(name);
+		for (auto& c : ret)
+			c = tolower((unsigned char)c);
+		return ret;
+	}
+	void PipelineManager::m_addToIndex(PipelineItem* item, PipelineItem* owner)
+	{
+		IndexEntry entry;
+		entry.Item = item;
+		entry.Owner = owner;
+		entry.Handle = ++m_lastHandle;
+
+		m_index[m_getKey(item->Name)] = entry;
+		m_handles[entry.Handle] = item;
+
+		m_publish(PipelineEvent::EventType::Add, item, owner);
+	}
+	void PipelineManager::m_removeFromIndex(PipelineItem* item)
+	{
+		SystemVariableManager::Instance().RemoveGeometryTransform(item);
+
+		auto it = m_index.find(m_getKey(item->Name));
+		if (it == m_index.end() || it->second.Item != item)
+			return;
+
+		m_publish(PipelineEvent::EventType::Remove, item, it->second.Owner);
+
+		m_handles.erase(it->second.Handle);
+		m_index.erase(it);
+	}
 	void PipelineManager::New(bool openTemplate)
 	{
 		Logger::Get().Log("Creating a new project from template");
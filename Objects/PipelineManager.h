@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include <string>
+#include <unordered_map>
 #include "../Options.h"
 #include "PipelineItem.h"
 
@@ -7,6 +9,23 @@ namespace ed
 {
 	class ProjectParser;
 
+	// a change of the pipeline item list - RenderEngine updates its cache from these
+	struct PipelineEvent
+	{
+		enum class EventType
+		{
+			Add,
+			Remove,
+			Move,
+			Rename
+		};
+
+		EventType Type;
+		PipelineItem* Item; // already deleted when Type == Remove, don't access it
+		void* Data;			// item's data at the time of the event
+		PipelineItem* Owner; // nullptr for passes
+	};
+
 	class PipelineManager
 	{
 	public:
@@ -22,10 +41,19 @@ namespace ed
 		bool AddComputePass(const char* name, pipe::ComputePass* data);
 		bool AddAudioPass(const char* name, pipe::AudioPass* data);
 		void Remove(const char* name);
+		bool Rename(PipelineItem* item, const char* name);
+		bool Move(PipelineItem* item, int index); // move the item to a different position in its owner's list
 		bool Has(const char* name);
 		PipelineItem* Get(const char* name);
 		char* GetItemOwner(const char* name);
-		inline std::vector<PipelineItem*>& GetList() { return m_items; }
+
+		// handles are never reused and stay the same when an item is renamed
+		int GetHandle(PipelineItem* item);
+		PipelineItem* GetByHandle(int handle);
+		inline std::vector<PipelineItem*>& GetList() { return m_items; } // use Move() to reorder the items
+
+		// events published since the last call, in order
+		void PollEvents(std::vector<PipelineEvent>& events);
 
 		void New(bool openTemplate = true);
 
@@ -35,5 +63,22 @@ namespace ed
 
 		ProjectParser* m_project;
 		std::vector<PipelineItem*> m_items;
+
+		struct IndexEntry
+		{
+			PipelineItem* Item;
+			PipelineItem* Owner; // nullptr for passes
+			int Handle;
+		};
+		std::unordered_map<std::string, IndexEntry> m_index; // lower case name -> item
+		std::unordered_map<int, PipelineItem*> m_handles;
+		int m_lastHandle;
+
+		std::string m_getKey(const char* name);
+		void m_addToIndex(PipelineItem* item, PipelineItem* owner);
+		void m_removeFromIndex(PipelineItem* item);
+
+		std::vector<PipelineEvent> m_events;
+		void m_publish(PipelineEvent::EventType type, PipelineItem* item, PipelineItem* owner);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "PipelineProfiler.h"
+#include <string.h>
+
+namespace ed
+{
+	void PipelineProfiler::History::Push(float cpu, float gpu, const float* breakdown, int size)
+	{
+		if (CPU.size() != size) {
+			CPU.resize(size, 0.0f);
+			GPU.resize(size, 0.0f);
+			for (int i = 0; i < (int)Category::Count; i++)
+				Breakdown[i].resize(size, 0.0f);
+			Next = 0;
+			Count = 0;
+		}
+
+		CPU[Next] = cpu;
+		GPU[Next] = gpu;
+		for (int i = 0; i < (int)Category::Count; i++)
+			Breakdown[i][Next] = breakdown[i];
+		Next = (Next + 1) % size;
+		Count++;
+	}
+	float PipelineProfiler::History::GetAverage(const std::vector<float>& samples) const
+	{
+		int sampleCount = std::min<int>(Count, samples.size());
+		if (sampleCount == 0)
+			return 0.0f;
+
+		float sum = 0.0f;
+		for (int i = 0; i < sampleCount; i++)
+			sum += samples[i];
+		return sum / sampleCount;
+	}
+	float PipelineProfiler::History::GetMax(const std::vector<float>& samples) const
+	{
+		int sampleCount = std::min<int>(Count, samples.size());
+
+		float ret = 0.0f;
+		for (int i = 0; i < sampleCount; i++)
+			ret = std::max(ret, samples[i]);
+		return ret;
+	}
+
+	PipelineProfiler::PipelineProfiler()
+	{
+		m_enabled = false;
+		m_inFrame = false;
+		m_historySize = PROFILER_HISTORY_SIZE;
+		m_curFrame = 0;
+		m_curItem = nullptr;
+		m_curQuery = -1;
+		m_curSubItem = nullptr;
+		m_curSubQuery = -1;
+		m_category = Category::Bind;
+
+		for (int i = 0; i < PROFILER_FRAME_LATENCY; i++) {
+			m_frames[i].Used = 0;
+			m_frames[i].Pending = false;
+			m_frames[i].CPU = 0.0f;
+		}
+	}
+	PipelineProfiler::~PipelineProfiler()
+	{
+		for (int i = 0; i < PROFILER_FRAME_LATENCY; i++)
+			for (auto& query : m_frames[i].Queries) {
+				glDeleteQueries(1, &query.ID);
+				glDeleteQueries(1, &query.EndID);
+			}
+	}
+	void PipelineProfiler::Reset()
+	{
+		if (m_curItem != nullptr)
+			EndItem();
+
+		// results of the queries still have to be read, otherwise the next glBeginQuery might fail
+		for (int i = 0; i < PROFILER_FRAME_LATENCY; i++) {
+			if (m_frames[i].Pending) {
+				GLuint64 dummy = 0;
+				for (int j = 0; j < m_frames[i].Used; j++) {
+					glGetQueryObjectui64v(m_frames[i].Queries[j].ID, GL_QUERY_RESULT, &dummy);
+					if (m_frames[i].Queries[j].Timestamp)
+						glGetQueryObjectui64v(m_frames[i].Queries[j].EndID, GL_QUERY_RESULT, &dummy);
+				}
+			}
+			m_frames[i].Used = 0;
+			m_frames[i].Pending = false;
+		}
+
+		m_history.clear();
+		m_frameHistory = History();
+	}
+	void PipelineProfiler::RemoveItem(PipelineItem* item)
+	{
+		for (int i = 0; i < PROFILER_FRAME_LATENCY; i++)
+			for (int j = 0; j < m_frames[i].Used; j++)
+				if (m_frames[i].Queries[j].Item == item)
+					m_frames[i].Queries[j].Item = nullptr;
+
+		m_history.erase(item);
+	}
+	void PipelineProfiler::BeginFrame()
+	{
+		if (!m_enabled)
+			return;
+
+		// we've run out of frames - wait for the oldest one
+		Frame& frame = m_frames[m_curFrame];
+		if (frame.Pending)
+			m_collect(frame, true);
+
+		frame.Used = 0;
+		m_inFrame = true;
+		m_frameStart = std::chrono::high_resolution_clock::now();
+	}
+	void PipelineProfiler::BeginItem(PipelineItem* item)
+	{
+		if (!m_inFrame)
+			return;
+
+		if (m_curItem != nullptr)
+			EndItem();
+
+		Frame& frame = m_frames[m_curFrame];
+		m_curQuery = frame.Used;
+
+		Query& query = m_allocQuery(frame);
+		query.Item = item;
+		query.Timestamp = false;
+
+		m_curItem = item;
+		m_itemStart = m_markTime = std::chrono::high_resolution_clock::now();
+		m_category = Category::Bind;
+		glBeginQuery(GL_TIME_ELAPSED, query.ID);
+	}
+	void PipelineProfiler::EndItem()
+	{
+		if (m_curItem == nullptr)
+			return;
+
+		EndSubItem();
+		Mark(Category::Bind);
+
+		glEndQuery(GL_TIME_ELAPSED);
+
+		Frame& frame = m_frames[m_curFrame];
+		frame.Queries[m_curQuery].CPU = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - m_itemStart).count();
+
+		m_curItem = nullptr;
+		m_curQuery = -1;
+	}
+	void PipelineProfiler::EndFrame()
+	{
+		if (!m_inFrame)
+			return;
+
+		EndItem();
+
+		m_frames[m_curFrame].CPU = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - m_frameStart).count();
+		m_frames[m_curFrame].Pending = true;
+		m_curFrame = (m_curFrame + 1) % PROFILER_FRAME_LATENCY;
+		m_inFrame = false;
+
+		// read the results in order, stop at the first frame that isn't finished yet
+		for (int i = 0; i < PROFILER_FRAME_LATENCY; i++) {
+			Frame& frame = m_frames[(m_curFrame + i) % PROFILER_FRAME_LATENCY];
+			if (frame.Pending && !m_collect(frame, false))
+				break;
+		}
+	}
+	void PipelineProfiler::BeginSubItem(PipelineItem* item)
+	{
+		if (m_curItem == nullptr)
+			return;
+
+		if (m_curSubItem != nullptr)
+			EndSubItem();
+
+		Mark(Category::Bind);
+
+		Frame& frame = m_frames[m_curFrame];
+		m_curSubQuery = frame.Used;
+
+		Query& query = m_allocQuery(frame);
+		query.Item = item;
+		query.Timestamp = true;
+
+		m_curSubItem = item;
+		m_subItemStart = m_markTime;
+		glQueryCounter(query.ID, GL_TIMESTAMP);
+	}
+	void PipelineProfiler::EndSubItem()
+	{
+		if (m_curSubItem == nullptr)
+			return;
+
+		Mark(Category::Bind);
+
+		Query& query = m_frames[m_curFrame].Queries[m_curSubQuery];
+		query.CPU = std::chrono::duration<float, std::milli>(m_markTime - m_subItemStart).count();
+		glQueryCounter(query.EndID, GL_TIMESTAMP);
+
+		m_curSubItem = nullptr;
+		m_curSubQuery = -1;
+	}
+	void PipelineProfiler::Mark(Category cat)
+	{
+		if (m_curItem == nullptr)
+			return;
+
+		TimePoint now = std::chrono::high_resolution_clock::now();
+		float elapsed = std::chrono::duration<float, std::milli>(now - m_markTime).count();
+
+		Frame& frame = m_frames[m_curFrame];
+		frame.Queries[m_curQuery].Breakdown[(int)m_category] += elapsed;
+		if (m_curSubItem != nullptr)
+			frame.Queries[m_curSubQuery].Breakdown[(int)m_category] += elapsed;
+
+		m_category = cat;
+		m_markTime = now;
+	}
+	void PipelineProfiler::Flush()
+	{
+		for (int i = 0; i < PROFILER_FRAME_LATENCY; i++) {
+			Frame& frame = m_frames[(m_curFrame + i) % PROFILER_FRAME_LATENCY];
+			if (frame.Pending)
+				m_collect(frame, true);
+		}
+	}
+	const PipelineProfiler::History* PipelineProfiler::GetHistory(PipelineItem* item)
+	{
+		auto it = m_history.find(item);
+		if (it == m_history.end())
+			return nullptr;
+		return &it->second;
+	}
+	PipelineProfiler::Query& PipelineProfiler::m_allocQuery(Frame& frame)
+	{
+		if (frame.Used >= frame.Queries.size()) {
+			Query query;
+			glGenQueries(1, &query.ID);
+			glGenQueries(1, &query.EndID);
+			frame.Queries.push_back(query);
+		}
+
+		Query& query = frame.Queries[frame.Used];
+		query.CPU = 0.0f;
+		memset(query.Breakdown, 0, sizeof(query.Breakdown));
+		frame.Used++;
+
+		return query;
+	}
+	bool PipelineProfiler::m_collect(Frame& frame, bool wait)
+	{
+		if (!wait && frame.Used > 0) {
+			// queries finish in order so checking the last top level item is enough (it ends after its sub items)
+			int last = frame.Used - 1;
+			while (last > 0 && frame.Queries[last].Timestamp)
+				last--;
+
+			GLint available = 0;
+			glGetQueryObjectiv(frame.Queries[last].ID, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+		}
+
+		float frameGPU = 0.0f;
+		float frameBreakdown[(int)Category::Count] = { 0.0f };
+		for (int i = 0; i < frame.Used; i++) {
+			const Query& query = frame.Queries[i];
+
+			GLuint64 elapsed = 0;
+			if (query.Timestamp) {
+				GLuint64 start = 0, end = 0;
+				glGetQueryObjectui64v(query.ID, GL_QUERY_RESULT, &start);
+				glGetQueryObjectui64v(query.EndID, GL_QUERY_RESULT, &end);
+				elapsed = end > start ? end - start : 0;
+			} else {
+				glGetQueryObjectui64v(query.ID, GL_QUERY_RESULT, &elapsed);
+
+				frameGPU += elapsed / 1000000.0f;
+				for (int j = 0; j < (int)Category::Count; j++)
+					frameBreakdown[j] += query.Breakdown[j];
+			}
+
+			if (query.Item != nullptr)
+				m_history[query.Item].Push(query.CPU, elapsed / 1000000.0f, query.Breakdown, m_historySize);
+		}
+
+		m_frameHistory.Push(frame.CPU, frameGPU, frameBreakdown, m_historySize);
+
+		frame.Used = 0;
+		frame.Pending = false;
+
+		return true;
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#if defined(__APPLE__)
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+
+#include <unordered_map>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+
+#define PROFILER_FRAME_LATENCY 4	// number of frames that can wait for the GPU query results
+#define PROFILER_HISTORY_SIZE 256
+
+namespace ed
+{
+	struct PipelineItem;
+
+	// measures CPU and GPU time spent on each top level pipeline item (GL_TIME_ELAPSED) and on
+	// each item inside of a shader pass (GL_TIMESTAMP, which can be used while GL_TIME_ELAPSED is active)
+	class PipelineProfiler
+	{
+	public:
+		// what the CPU time is spent on
+		enum class Category
+		{
+			Bind,		// FBOs, clearing, shaders, textures, states
+			Uniforms,	// updating & uploading the variables
+			Draw,		// draw calls & plugin items
+			Count
+		};
+
+		// ring buffer of the last N samples (in milliseconds)
+		struct History
+		{
+			History() : Next(0), Count(0) {}
+
+			std::vector<float> CPU;
+			std::vector<float> GPU;
+			std::vector<float> Breakdown[(int)Category::Count]; // CPU split into categories
+			int Next;			// position of the next sample
+			size_t Count;		// number of samples recorded since the last reset
+
+			void Push(float cpu, float gpu, const float* breakdown, int size);
+			inline int Size() const { return CPU.size(); }
+
+			float GetAverage(const std::vector<float>& samples) const;
+			float GetMax(const std::vector<float>& samples) const;
+		};
+
+		PipelineProfiler();
+		~PipelineProfiler();
+
+		inline void SetEnabled(bool enabled) { m_enabled = enabled; }
+		inline bool IsEnabled() { return m_enabled; }
+
+		inline void SetHistorySize(int size) { m_historySize = std::max(1, size); Reset(); }
+		inline int GetHistorySize() { return m_historySize; }
+
+		// remove the history and drop the queries that are still waiting for results
+		void Reset();
+
+		// forget the item's history, the results of its queries that are still pending are ignored
+		void RemoveItem(PipelineItem* item);
+
+		void BeginFrame();
+		void BeginItem(PipelineItem* item); // also ends the previous item
+		void EndItem();
+		void EndFrame();
+
+		// items inside of the current shader pass
+		void BeginSubItem(PipelineItem* item);
+		void EndSubItem();
+
+		// the CPU time from now on is spent on the given category
+		void Mark(Category cat);
+
+		// wait for all the queries to finish
+		void Flush();
+
+		// nullptr if the item wasn't profiled yet
+		const History* GetHistory(PipelineItem* item);
+		inline const std::unordered_map<PipelineItem*, History>& GetHistoryList() { return m_history; }
+		inline const History& GetFrameHistory() { return m_frameHistory; }
+
+	private:
+		struct Query
+		{
+			PipelineItem* Item;
+			GLuint ID;			// GL_TIME_ELAPSED query or the start timestamp
+			GLuint EndID;		// end timestamp
+			bool Timestamp;
+			float CPU;
+			float Breakdown[(int)Category::Count];
+		};
+		struct Frame
+		{
+			std::vector<Query> Queries;
+			int Used;
+			bool Pending;
+			float CPU;
+		};
+
+		Query& m_allocQuery(Frame& frame);
+
+		// returns false if the results aren't available yet and wait == false
+		bool m_collect(Frame& frame, bool wait);
+
+		bool m_enabled;
+		bool m_inFrame;
+		int m_historySize;
+
+		Frame m_frames[PROFILER_FRAME_LATENCY];
+		int m_curFrame;
+
+		typedef std::chrono::time_point<std::chrono::high_resolution_clock> TimePoint;
+
+		PipelineItem* m_curItem;
+		int m_curQuery;
+		TimePoint m_frameStart, m_itemStart;
+
+		PipelineItem* m_curSubItem;
+		int m_curSubQuery;
+		TimePoint m_subItemStart;
+
+		Category m_category;
+		TimePoint m_markTime;
+
+		std::unordered_map<PipelineItem*, History> m_history;
+		History m_frameHistory;
+	};
+}
@@ -34,8 +34,27 @@ namespace ed
 		for (const auto& plugin : m_plugins)
 			plugin->OnEvent((void*)&e);
 	}
+	PluginManager::PluginManager()
+	{
+		m_data = nullptr;
+		m_ui = nullptr;
+		m_loaded = false;
+	}
 	void PluginManager::Init(InterfaceManager* data, GUIManager* ui)
 	{
+		m_data = data;
+		m_ui = ui;
+	}
+	void PluginManager::Load()
+	{
+		if (m_loaded || m_data == nullptr)
+			return;
+
+		m_loaded = true;
+
+		InterfaceManager* data = m_data;
+		GUIManager* ui = m_ui;
+
 		if (!ghc::filesystem::exists("./plugins/")) {
 			ed::Logger::Get().Log("Directory for plugins doesn't exist");
 			return;
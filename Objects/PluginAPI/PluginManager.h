@@ -16,7 +16,10 @@ namespace ed
 	class PluginManager
 	{
 	public:
-		void Init(InterfaceManager* data, GUIManager* ui); // load all the plugins here
+		PluginManager();
+
+		void Init(InterfaceManager* data, GUIManager* ui); // plugins aren't loaded until Load() is called
+		void Load(); // load all the plugins here (does nothing if they are already loaded)
 		void Destroy(); // destroy all the plugins
 		void Update(float delta);
 
@@ -47,8 +50,13 @@ namespace ed
 		void OnEvent(const SDL_Event& e);
 
 		inline const std::vector<IPlugin*>& Plugins() { return m_plugins; }
+		inline bool IsLoaded() { return m_loaded; }
 
 	private:
+		InterfaceManager* m_data;
+		GUIManager* m_ui;
+		bool m_loaded;
+
 		std::vector<void*> m_proc;
 		std::vector<IPlugin*> m_plugins;
 		std::vector<bool> m_isActive;
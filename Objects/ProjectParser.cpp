@@ -22,6 +22,7 @@
 #include "../Engine/GeometryFactory.h"
 
 #include <fstream>
+#include <algorithm>
 #include <ghc/filesystem.hpp>
 
 #define HARRAYSIZE(a) (sizeof(a)/sizeof(*a))
@@ -78,6 +79,7 @@ namespace ed
 		}
 
 		// check if user has all required plugins
+		m_plugins->Load();
 		m_pluginList.clear();
 		bool pluginTest = true;
 		pugi::xml_node pluginsContainerNode = doc.child("project").child("plugins");
@@ -93,6 +95,11 @@ namespace ed
 
 				std::string msg = "The project you are trying to open requires plugin " + pname + ".\nDo you want to install the plugin?";
 
+				if (m_ui == nullptr) {
+					Logger::Get().Log("Project requires plugin " + pname, true);
+					break;
+				}
+
 				const SDL_MessageBoxButtonData buttons[] = {
 					{ /* .flags, .buttonid, .text */        0, 1, "NO" },
 					{ SDL_MESSAGEBOX_BUTTON_RETURNKEY_DEFAULT, 0, "YES" },
@@ -121,6 +128,11 @@ namespace ed
 
 				std::string msg = "The project you are trying to open requires plugin " + pname + " which you have installed.\nEnable the plugin in the options.";
 
+				if (m_ui == nullptr) {
+					Logger::Get().Log("Project requires plugin " + pname + " which is not active", true);
+					break;
+				}
+
 				const SDL_MessageBoxButtonData buttons[] = {
 					{ SDL_MESSAGEBOX_BUTTON_RETURNKEY_DEFAULT, 0, "OK" },
 				};
@@ -148,6 +160,11 @@ namespace ed
 					std::string msg = "The project you are trying to open requires plugin " + pname + " version " + std::to_string(pver) + 
 						" while you have version " + std::to_string(instPVer) + " installed.\nDo you want to update your plugin?";
 
+					if (m_ui == nullptr) {
+						Logger::Get().Log("Project requires plugin " + pname + " version " + std::to_string(pver), true);
+						break;
+					}
+
 					const SDL_MessageBoxButtonData buttons[] = {
 						{ /* .flags, .buttonid, .text */        0, 1, "NO" },
 						{ SDL_MESSAGEBOX_BUTTON_RETURNKEY_DEFAULT, 0, "YES" },
@@ -251,7 +268,9 @@ namespace ed
 		SetProjectDirectory(file.substr(0, file.find_last_of("/\\")));
 
 		std::vector<PipelineItem*> passItems = m_pipe->GetList();
-		std::vector<pipe::ShaderPass*> collapsedSP = ((PipelineUI*)m_ui->Get(ViewID::Pipeline))->GetCollapsedItems();
+		std::vector<pipe::ShaderPass*> collapsedSP;
+		if (m_ui != nullptr)
+			collapsedSP = ((PipelineUI*)m_ui->Get(ViewID::Pipeline))->GetCollapsedItems();
 
 		std::string projectStem = "proj";
 		if (ghc::filesystem::path(file).has_stem())
@@ -408,6 +427,9 @@ namespace ed
 						passNode.append_child("rendertexture").append_attribute("name").set_value(m_objects->GetRenderTexture(rtID)->Name.c_str());
 				}
 
+				// execution rate
+				m_exportPassRate(passNode, passData->RunEvery, passData->MaxRate, passData->Slices);
+
 				// pass items
 				pugi::xml_node itemsNode = passNode.append_child("items");
 				m_exportItems(itemsNode, passData->Items, oldProjectPath);
@@ -472,6 +494,9 @@ namespace ed
 				workNode.append_attribute("y").set_value(passData->WorkY);
 				workNode.append_attribute("z").set_value(passData->WorkZ);
 
+				// execution rate
+				m_exportPassRate(passNode, passData->RunEvery, passData->MaxRate, passData->Slices);
+
 				// variables -> now global in pass element [V2]
 				m_exportShaderVariables(passNode, passData->Variables.GetVariables());
 
@@ -586,6 +611,7 @@ namespace ed
 						textureNode.append_attribute("rsize").set_value((std::to_string(rtObj->RatioSize.x) + "," + std::to_string(rtObj->RatioSize.y)).c_str());
 
 					textureNode.append_attribute("clear").set_value(rtObj->Clear);
+					if (rtObj->Transient) textureNode.append_attribute("transient").set_value(true);
 					if (rtObj->ClearColor.r != 0) textureNode.append_attribute("r").set_value(rtObj->ClearColor.r);
 					if (rtObj->ClearColor.g != 0) textureNode.append_attribute("g").set_value(rtObj->ClearColor.g);
 					if (rtObj->ClearColor.b != 0) textureNode.append_attribute("b").set_value(rtObj->ClearColor.b);
@@ -717,8 +743,8 @@ namespace ed
 		// settings
 		{
 			// property ui
-			PropertyUI* props = ((PropertyUI*)m_ui->Get(ViewID::Properties));
-			if (props->HasItemSelected()) {
+			PropertyUI* props = m_ui == nullptr ? nullptr : ((PropertyUI*)m_ui->Get(ViewID::Properties));
+			if (props != nullptr && props->HasItemSelected()) {
 				std::string name = props->CurrentItemName();
 
 				pugi::xml_node propNode = settingsNode.append_child("entry");
@@ -728,8 +754,9 @@ namespace ed
 			}
 
 			// code editor ui
-			CodeEditorUI* editor = ((CodeEditorUI*)m_ui->Get(ViewID::Code));
-			std::vector<std::pair<std::string, int>> files = editor->GetOpenedFiles();
+			std::vector<std::pair<std::string, int>> files;
+			if (m_ui != nullptr)
+				files = ((CodeEditorUI*)m_ui->Get(ViewID::Code))->GetOpenedFiles();
 			for (const auto& file : files) {
 				pugi::xml_node fileNode = settingsNode.append_child("entry");
 				fileNode.append_attribute("type").set_value("file");
@@ -738,8 +765,9 @@ namespace ed
 			}
 
 			// pinned ui
-			PinnedUI* pinned = ((PinnedUI*)m_ui->Get(ViewID::Pinned));
-			std::vector<ShaderVariable*> pinnedVars = pinned->GetAll();
+			std::vector<ShaderVariable*> pinnedVars;
+			if (m_ui != nullptr)
+				pinnedVars = ((PinnedUI*)m_ui->Get(ViewID::Pinned))->GetAll();
 			for (const auto& var : pinnedVars) {
 				pugi::xml_node varNode = settingsNode.append_child("entry");
 				varNode.append_attribute("type").set_value("pinned");
@@ -1041,6 +1069,23 @@ namespace ed
 			}
 		}
 	}
+	void ProjectParser::m_exportPassRate(pugi::xml_node& passNode, int runEvery, float maxRate, int slices)
+	{
+		if (runEvery <= 1 && maxRate <= 0.0f && slices <= 1)
+			return;
+
+		pugi::xml_node rateNode = passNode.append_child("rate");
+		rateNode.append_attribute("every").set_value(runEvery);
+		rateNode.append_attribute("hz").set_value(maxRate);
+		rateNode.append_attribute("slices").set_value(slices);
+	}
+	void ProjectParser::m_parsePassRate(const pugi::xml_node& passNode, int& runEvery, float& maxRate, int& slices)
+	{
+		pugi::xml_node rateNode = passNode.child("rate");
+		runEvery = std::max(rateNode.attribute("every").as_int(1), 1);
+		maxRate = std::max(rateNode.attribute("hz").as_float(0.0f), 0.0f);
+		slices = std::max(rateNode.attribute("slices").as_int(1), 1);
+	}
 	void ProjectParser::m_exportShaderVariables(pugi::xml_node& node, std::vector<ShaderVariable*>& vars)
 	{
 		if (vars.size() > 0) {
@@ -1557,7 +1602,7 @@ namespace ed
 			// check if it should be collapsed
 			if (!passNode.attribute("collapsed").empty()) {
 				bool cs = passNode.attribute("collapsed").as_bool();
-				if (cs)
+				if (cs && m_ui != nullptr)
 					((PipelineUI*)m_ui->Get(ViewID::Pipeline))->Collapse(data);
 			}
 
@@ -2035,14 +2080,14 @@ namespace ed
 		for (pugi::xml_node settingItem : projectNode.child("settings").children("entry")) {
 			if (!settingItem.attribute("type").empty()) {
 				std::string type = settingItem.attribute("type").as_string();
-				if (type == "property") {
+				if (type == "property" && m_ui != nullptr) {
 					PropertyUI* props = ((PropertyUI*)m_ui->Get(ViewID::Properties));
 					if (!settingItem.attribute("name").empty()) {
 						PipelineItem* item = m_pipe->Get(settingItem.attribute("name").as_string());
 						props->Open(item);
 					}
 				}
-				else if (type == "file" && Settings::Instance().General.ReopenShaders) {
+				else if (type == "file" && Settings::Instance().General.ReopenShaders && m_ui != nullptr) {
 					CodeEditorUI* editor = ((CodeEditorUI*)m_ui->Get(ViewID::Code));
 					if (!settingItem.attribute("name").empty()) {
 						PipelineItem* item = m_pipe->Get(settingItem.attribute("name").as_string());
@@ -2064,7 +2109,7 @@ namespace ed
 							editor->OpenGS(item);
 					}
 				}
-				else if (type == "pinned") {
+				else if (type == "pinned" && m_ui != nullptr) {
 					PinnedUI* pinned = ((PinnedUI*)m_ui->Get(ViewID::Pinned));
 					if (!settingItem.attribute("name").empty()) {
 						const pugi::char_t* item = settingItem.attribute("name").as_string();
@@ -2173,7 +2218,7 @@ namespace ed
 				// check if it should be collapsed
 				if (!passNode.attribute("collapsed").empty()) {
 					bool cs = passNode.attribute("collapsed").as_bool();
-					if (cs)
+					if (cs && m_ui != nullptr)
 						((PipelineUI*)m_ui->Get(ViewID::Pipeline))->Collapse(data);
 				}
 
@@ -2188,6 +2233,9 @@ namespace ed
 				}
 				data->RTCount = (rtCur == 0) ? 1 : rtCur;
 
+				// execution rate
+				m_parsePassRate(passNode, data->RunEvery, data->MaxRate, data->Slices);
+
 				// add the item
 				m_pipe->AddShaderPass(name, data);
 
@@ -2472,6 +2520,9 @@ namespace ed
 				if (!workNode.attribute("z").empty()) data->WorkZ = workNode.attribute("z").as_uint();
 				else data->WorkZ = 1;
 
+				// execution rate
+				m_parsePassRate(passNode, data->RunEvery, data->MaxRate, data->Slices);
+
 				// add the item
 				m_pipe->AddComputePass(name, data);
 			} 
@@ -2673,6 +2724,9 @@ namespace ed
 					}
 				}
 
+				// load transient flag (before the size - the buffers are allocated by ResizeRenderTexture)
+				rt->Transient = objectNode.attribute("transient").as_bool(false);
+
 				// load size
 				if (objectNode.attribute("fsize").empty()) { // load RatioSize if attribute fsize (FixedSize) doesnt exist
 					std::string rtSize = objectNode.attribute("rsize").as_string();
@@ -2982,7 +3036,7 @@ namespace ed
 		for (pugi::xml_node settingItem : projectNode.child("settings").children("entry")) {
 			if (!settingItem.attribute("type").empty()) {
 				std::string type = settingItem.attribute("type").as_string();
-				if (type == "property") {
+				if (type == "property" && m_ui != nullptr) {
 					PropertyUI* props = ((PropertyUI*)m_ui->Get(ViewID::Properties));
 					if (!settingItem.attribute("name").empty()) {
 						int type = 0; // pipeline item
@@ -3002,7 +3056,7 @@ namespace ed
 							props->Open(itemName, m_objects->GetObjectManagerItem(itemName));
 					}
 				}
-				else if (type == "file" && Settings::Instance().General.ReopenShaders) {
+				else if (type == "file" && Settings::Instance().General.ReopenShaders && m_ui != nullptr) {
 					CodeEditorUI* editor = ((CodeEditorUI*)m_ui->Get(ViewID::Code));
 					if (!settingItem.attribute("name").empty()) {
 						PipelineItem* item = m_pipe->Get(settingItem.attribute("name").as_string());
@@ -3033,7 +3087,7 @@ namespace ed
 						}
 					}
 				}
-				else if (type == "pinned") {
+				else if (type == "pinned" && m_ui != nullptr) {
 					PinnedUI* pinned = ((PinnedUI*)m_ui->Get(ViewID::Pinned));
 					if (!settingItem.attribute("name").empty()) {
 						const pugi::char_t* item = settingItem.attribute("name").as_string();
@@ -68,6 +68,8 @@ namespace ed
 		void m_parseVariableValue(pugi::xml_node& node, ShaderVariable* var);
 		void m_exportVariableValue(pugi::xml_node& node, ShaderVariable* vars);
 		void m_exportShaderVariables(pugi::xml_node& node, std::vector<ShaderVariable*>& vars);
+		void m_exportPassRate(pugi::xml_node& passNode, int runEvery, float maxRate, int slices); // <rate> node, only if it isn't the default
+		void m_parsePassRate(const pugi::xml_node& passNode, int& runEvery, float& maxRate, int& slices);
 		GLenum m_toBlend(const char* str);
 		GLenum m_toBlendOp(const char* str);
 		GLenum m_toComparisonFunc(const char* str);
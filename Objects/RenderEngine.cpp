@@ -6,6 +6,9 @@
 #include "ObjectManager.h"
 #include "PipelineManager.h"
 #include "SystemVariableManager.h"
+#include "FunctionVariableManager.h"
+#include "ShaderPreprocessor.h"
+#include "Tracer.h"
 #include "../Engine/GeometryFactory.h"
 #include "../Engine/GLUtils.h"
 #include "../Engine/Ray.h"
@@ -14,6 +17,8 @@
 #include <ghc/filesystem.hpp>
 #include <glm/gtx/intersect.hpp>
 
+#include "../Engine/GLCallCounterHooks.h"
+
 static const GLenum fboBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4, GL_COLOR_ATTACHMENT5, GL_COLOR_ATTACHMENT6, GL_COLOR_ATTACHMENT7, GL_COLOR_ATTACHMENT8, GL_COLOR_ATTACHMENT9, GL_COLOR_ATTACHMENT10, GL_COLOR_ATTACHMENT11, GL_COLOR_ATTACHMENT12, GL_COLOR_ATTACHMENT13, GL_COLOR_ATTACHMENT14, GL_COLOR_ATTACHMENT15 };
 static const char* PixelDebugShaderCode = R"(
 #version 330
@@ -73,7 +78,8 @@ namespace ed
 		m_rtDepth(0),
 		m_fbosNeedUpdate(false),
 		m_computeSupported(true),
-		m_wasMultiPick(false)
+		m_wasMultiPick(false),
+		m_cacheRebuild(true)
 	{
 		m_paused = false;
 
@@ -97,6 +103,12 @@ namespace ed
 		psCompiled = gl::CheckShaderCompilationStatus(m_debugVertexPickShader, msg);
 		if (!psCompiled)
 			Logger::Get().Log("Failed to compile the pixel shader used for getting instance ID.", true);
+
+		memset(&m_systemBlock, 0, sizeof(m_systemBlock));
+		glGenBuffers(1, &m_systemUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_systemUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(SystemUniformBlock), &m_systemBlock, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 	RenderEngine::~RenderEngine()
 	{
@@ -107,11 +119,15 @@ namespace ed
 		glDeleteShader(m_debugPixelShader);
 		glDeleteShader(m_debugVertexPickShader);
 		glDeleteShader(m_debugInstancePickShader);
+		glDeleteBuffers(1, &m_systemUBO);
 		FlushCache();
 	}
 	void RenderEngine::Render(int width, int height, bool isDebug)
 	{
+		TRACE_ZONE("RenderEngine::Render");
+
 		bool isMSAA = (Settings::Instance().Preview.MSAA != 1) && !isDebug;
+		gl::CallCounter::Instance().SetEnabled(Settings::Instance().Preview.GLCallCounters);
 
 		if (isMSAA)
 			glEnable(GL_MULTISAMPLE);
@@ -151,29 +167,69 @@ namespace ed
 		}
 
 		// cache elements
-		m_cache();
+		{
+			TRACE_ZONE("RenderEngine::m_cache");
+			m_cache();
+		}
 
 		auto& systemVM = SystemVariableManager::Instance();
+		systemVM.BeginFrame();
 
-		auto& itemVarValues = GetItemVariableValues();
 		GLuint previousTexture[MAX_RENDER_TEXTURES] = { 0 }; // dont clear the render target if we use it two times in a row
-		GLuint previousDepth = 0;
+		GLuint previousDepth = 0; // last RT of the previous pass (owner of the depth texture)
 		bool clearedWindow = false;
 		int debugID = DEBUG_ID_START;
 
 		m_plugins->BeginRender();
 
+		if (!isDebug)
+			m_profiler.BeginFrame();
+
+		// user's uniform buffers are bound to 0..N so the system block can stay bound
+		glBindBufferBase(GL_UNIFORM_BUFFER, SYSTEM_UBO_BINDING, m_systemUBO);
+		m_updateSystemUBO();
+
+		// function variables
+		{
+			std::vector<const ShaderVariableContainer*> containers;
+			for (PipelineItem* it : m_items) {
+				if (it->Type == PipelineItem::ItemType::ShaderPass)
+					containers.push_back(&((pipe::ShaderPass*)it->Data)->Variables);
+				else if (it->Type == PipelineItem::ItemType::ComputePass)
+					containers.push_back(&((pipe::ComputePass*)it->Data)->Variables);
+				else if (it->Type == PipelineItem::ItemType::AudioPass)
+					containers.push_back(&((pipe::AudioPass*)it->Data)->Variables);
+			}
+			FunctionVariableManager::Evaluate(containers);
+		}
+
+		// find the passes whose output isn't visible anywhere
+		m_graph.Build(m_items, m_objects, m_rtColor);
+		bool skipUnused = Settings::Instance().Preview.SkipUnusedPasses;
+
+		// share the buffers of the transient render textures
+		if (m_rtPool.Build(m_items, m_objects, width, height))
+			for (auto& fboCount : m_fboCount)
+				fboCount.second = 0; // FBOs have to be recreated with the new attachments
+
 		for (int i = 0; i < m_items.size(); i++) {
 			PipelineItem* it = m_items[i];
 
+			if (skipUnused && !m_graph.IsUsed(i))
+				continue;
+
+			TRACE_ZONE(it->Name);
+			m_profiler.BeginItem(it);
+
+			systemVM.SetPassSlice(0, 1);
+
 			if (it->Type == PipelineItem::ItemType::ShaderPass) {
 				pipe::ShaderPass* data = (pipe::ShaderPass*)it->Data;
 
 				if (!data->Active || data->Items.size() <= 0 || data->RTCount == 0 || (isDebug && data->GSUsed))
 					continue;
 
-				const std::vector<GLuint>& srvs = m_objects->GetBindList(m_items[i]);
-				const std::vector<GLuint>& ubos = m_objects->GetUniformBindList(m_items[i]);
+				const BindTable& binds = m_objects->GetBindTable(m_items[i]);
 
 				// create/update fbo if necessary
 				m_updatePassFBO(data);
@@ -181,18 +237,49 @@ namespace ed
 				if (m_shaders[i] == 0)
 					continue;
 
+				// rate limited passes keep the render textures from their last execution
+				int slice = 0;
+				if (!isDebug && !m_pickAwaiting && !m_isPassScheduled(it, data->RunEvery, data->MaxRate, data->Slices, slice)) {
+					for (int j = 0; j < data->RTCount; j++)
+						previousTexture[j] = data->RenderTextures[j];
+					previousDepth = data->RenderTextures[data->RTCount - 1];
+					continue;
+				}
+
+				// reuse the render textures if nothing that the pass reads has changed since it was last rendered
+				if (!isDebug && m_isPassCached(i, width, height) && !m_pickAwaiting) {
+					// the pass still counts as the last one that used its targets
+					for (int j = 0; j < data->RTCount; j++)
+						previousTexture[j] = data->RenderTextures[j];
+					previousDepth = data->RenderTextures[data->RTCount - 1];
+					continue;
+				}
+
 				// bind fbo and buffers
 				glBindFramebuffer(GL_FRAMEBUFFER, isMSAA ? m_fboMS[data] : data->FBO);
 				glDrawBuffers(data->RTCount, fboBuffers);
 
-				// clear depth texture
-				if (data->DepthTexture != previousDepth) {
-					if ((data->DepthTexture == m_rtDepth && !clearedWindow) || data->DepthTexture != m_rtDepth) {
+				// time sliced passes only render (and clear) one horizontal strip of their render textures
+				bool isSliced = !isDebug && !m_pickAwaiting && data->Slices > 1;
+				if (isSliced) {
+					GLuint lastRT = data->RenderTextures[data->RTCount - 1];
+					glm::ivec2 size = lastRT == m_rtColor ? glm::ivec2(width, height) : m_objects->GetRenderTexture(lastRT)->CalculateSize(width, height);
+					int top = size.y * slice / data->Slices, bottom = size.y * (slice + 1) / data->Slices;
+
+					glEnable(GL_SCISSOR_TEST);
+					glScissor(0, top, size.x, bottom - top);
+					systemVM.SetPassSlice(slice, data->Slices);
+				}
+
+				// clear depth texture (the depth texture belongs to the last RT, transient RTs can share it)
+				GLuint depthOwner = data->RenderTextures[data->RTCount - 1];
+				if (depthOwner != previousDepth) {
+					if ((depthOwner == m_rtColor && !clearedWindow) || depthOwner != m_rtColor) {
 						glStencilMask(0xFFFFFFFF);
 						glClearBufferfi(GL_DEPTH_STENCIL, 0, 1.0f, 0);
 					}
 
-					previousDepth = data->DepthTexture;
+					previousDepth = depthOwner;
 				}
 
 				// bind RTs
@@ -234,6 +321,7 @@ namespace ed
 				// update viewport value
 				systemVM.SetViewportSize(rtSize.x, rtSize.y);
 				glViewport(0, 0, rtSize.x, rtSize.y);
+				m_updateSystemUBO();
 
 				// bind shaders
 
@@ -244,25 +332,17 @@ namespace ed
 					glUseProgram(m_shaders[i]);
 
 				// bind shader resource views
-				for (int j = 0; j < srvs.size(); j++) {
+				for (int j = 0; j < binds.Textures.size(); j++) {
+					const ResourceBind& srv = binds.Textures[j];
 					glActiveTexture(GL_TEXTURE0 + j);
-					if (m_objects->IsCubeMap(srvs[j]))
-						glBindTexture(GL_TEXTURE_CUBE_MAP, srvs[j]);
-					else if (m_objects->IsImage3D(srvs[j]))
-						glBindTexture(GL_TEXTURE_3D, srvs[j]);
-					else if (m_objects->IsPluginObject(srvs[j])) {
-						PluginObject* pobj = m_objects->GetPluginObject(srvs[j]);
-						pobj->Owner->BindObject(pobj->Type, pobj->Data, pobj->ID);
-					}
+					if (srv.Plugin != nullptr)
+						srv.Plugin->Owner->BindObject(srv.Plugin->Type, srv.Plugin->Data, srv.Plugin->ID);
 					else
-						glBindTexture(GL_TEXTURE_2D, srvs[j]);
-
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath) == ShaderLanguage::GLSL) // TODO: or should this be for vulkan glsl too?
-						data->Variables.UpdateTexture(m_shaders[i], j);
+						glBindTexture(srv.Target, srv.ID);
 				}
 
-				for (int j = 0; j < ubos.size(); j++)
-					glBindBufferBase(GL_UNIFORM_BUFFER, j, ubos[j]);
+				for (int j = 0; j < binds.Buffers.size(); j++)
+					glBindBufferBase(GL_UNIFORM_BUFFER, j, binds.Buffers[j].ID);
 				
 				// clear messages
 				//if (m_msgs->GetGroupWarningMsgCount(it->Name) > 0)
@@ -275,14 +355,13 @@ namespace ed
 				for (int j = 0; j < data->Items.size(); j++) {
 					PipelineItem* item = data->Items[j];
 
+					m_profiler.BeginSubItem(item);
+
 					systemVM.SetPicked(false);
 
 					// update the value for this element and check if we picked it
 					if (item->Type == PipelineItem::ItemType::Geometry || item->Type == PipelineItem::ItemType::Model) {
 						if (m_pickAwaiting) m_pickItem(item, m_wasMultiPick);
-						for (int k = 0; k < itemVarValues.size(); k++)
-							if (itemVarValues[k].Item == item)
-								itemVarValues[k].Variable->Data = itemVarValues[k].NewValue->Data;
 
 						if (isDebug) {
 							float r = (debugID & 0x000000FF) / 255.0f;
@@ -296,19 +375,13 @@ namespace ed
 					if (item->Type == PipelineItem::ItemType::Geometry) {
 						pipe::GeometryItem* geoData = reinterpret_cast<pipe::GeometryItem*>(item->Data);
 
-						if (geoData->Type == pipe::GeometryItem::Rectangle) {
-							// TODO: don't multiply with m_renderer->GetLastRenderSize() but rather with actual RT size
-							glm::vec3 scaleRect(geoData->Scale.x * width, geoData->Scale.y * height, 1.0f);
-							glm::vec3 posRect((geoData->Position.x + 0.5f) * width, (geoData->Position.y + 0.5f) * height, -1000.0f);
-							systemVM.SetGeometryTransform(item, scaleRect, geoData->Rotation, posRect);
-						} else
-							systemVM.SetGeometryTransform(item, geoData->Scale, geoData->Rotation, geoData->Position);
-
-						systemVM.SetPicked(std::count(m_pick.begin(), m_pick.end(), item));
+						m_updateItemValues(item, width, height);
 
 						// bind variables
+						m_profiler.Mark(PipelineProfiler::Category::Uniforms);
 						data->Variables.Bind(item);
 
+						m_profiler.Mark(PipelineProfiler::Category::Draw);
 						glBindVertexArray(geoData->VAO);
 						if (geoData->Instanced)
 							glDrawArraysInstanced(geoData->Topology, 0, eng::GeometryFactory::VertexCount[geoData->Type], geoData->InstanceCount);
@@ -318,12 +391,13 @@ namespace ed
 					else if (item->Type == PipelineItem::ItemType::Model) {
 						pipe::Model* objData = reinterpret_cast<pipe::Model*>(item->Data);
 
-						systemVM.SetPicked(std::count(m_pick.begin(), m_pick.end(), item));
-						systemVM.SetGeometryTransform(item, objData->Scale, objData->Rotation, objData->Position);
+						m_updateItemValues(item, width, height);
 
 						// bind variables
+						m_profiler.Mark(PipelineProfiler::Category::Uniforms);
 						data->Variables.Bind(item);
 
+						m_profiler.Mark(PipelineProfiler::Category::Draw);
 						objData->Data->Draw(objData->Instanced, objData->InstanceCount);
 					}
 					else if (item->Type == PipelineItem::ItemType::RenderState) {
@@ -389,14 +463,11 @@ namespace ed
 						else
 							systemVM.SetPicked(false);
 
+						m_profiler.Mark(PipelineProfiler::Category::Draw);
 						pldata->Owner->ExecutePipelineItem(data, plugin::PipelineItemType::ShaderPass, pldata->Type, pldata->PluginData);
 					}
 
-					// set the old value back
-					if (item->Type == PipelineItem::ItemType::Geometry || item->Type == PipelineItem::ItemType::Model)
-						for (int k = 0; k < itemVarValues.size(); k++)
-							if (itemVarValues[k].Item == item)
-								itemVarValues[k].Variable->Data = itemVarValues[k].OldValue;
+					m_profiler.EndSubItem();
 				}
 
 				if (isDebug)
@@ -413,104 +484,131 @@ namespace ed
 						glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 					}
 				}
+
+				if (isSliced)
+					glDisable(GL_SCISSOR_TEST);
+
+				// passes that read these textures have to be rendered again
+				for (int j = 0; j < data->RTCount; j++)
+					m_textureVersions[data->RenderTextures[j]]++;
 			}
 			else if (it->Type == PipelineItem::ItemType::ComputePass && !isDebug && m_computeSupported) {
 				pipe::ComputePass *data = (pipe::ComputePass *)it->Data;
 
-				const std::vector<GLuint>& srvs = m_objects->GetBindList(m_items[i]);
-				const std::vector<GLuint>& ubos = m_objects->GetUniformBindList(m_items[i]);
+				const BindTable& binds = m_objects->GetBindTable(m_items[i]);
 
 				if (m_shaders[i] == 0)
 					continue;
+
+				if (data->Frozen && m_isPassCached(i, width, height))
+					continue;
+
+				// without PassSlice every slice would process the same work groups
+				int slices = data->Slices;
+				if (slices > 1 && !data->Variables.UsesSystemVariable(SystemShaderVariable::PassSlice)) {
+					if (m_unslicedPasses.insert(it).second)
+						Logger::Get().Log("Compute pass " + std::string(it->Name) + " is split into " + std::to_string(slices) + " slices but doesn't use the PassSlice system variable - dispatching all the work groups every time");
+					slices = 1;
+				}
+
+				int slice = 0;
+				if (!m_isPassScheduled(it, data->RunEvery, data->MaxRate, slices, slice))
+					continue;
+
+				// slice N covers the work groups [WorkX*N/Slices, WorkX*(N+1)/Slices) along X so that no slice goes past WorkX
+				GLuint firstGroup = 0, groupCount = data->WorkX;
+				if (slices > 1) {
+					firstGroup = data->WorkX * slice / slices;
+					groupCount = data->WorkX * (slice + 1) / slices - firstGroup;
+					systemVM.SetPassSlice(slice, slices, firstGroup, groupCount);
+				}
 				
 				// bind shaders
 				glUseProgram(m_shaders[i]);
 
 				// bind shader resource views
-				for (int j = 0; j < srvs.size(); j++)
+				for (int j = 0; j < binds.Textures.size(); j++)
 				{
 					glActiveTexture(GL_TEXTURE0 + j);
-					if (m_objects->IsCubeMap(srvs[j]))
-						glBindTexture(GL_TEXTURE_CUBE_MAP, srvs[j]);
-					else if (m_objects->IsImage3D(srvs[j]))
-						glBindTexture(GL_TEXTURE_3D, srvs[j]);
-					else
-						glBindTexture(GL_TEXTURE_2D, srvs[j]);
-
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL) // TODO: or should this be for vulkan glsl too?
-						data->Variables.UpdateTexture(m_shaders[i], j);
+					glBindTexture(binds.Textures[j].Target, binds.Textures[j].ID);
 				}
 
 				// bind buffers
-				for (int j = 0; j < ubos.size(); j++) {
-					if (m_objects->IsImage(ubos[j])) {
-						ImageObject* iobj = m_objects->GetImage(m_objects->GetImageNameByID(ubos[j])); // TODO: GetImageByID
-						glBindImageTexture(j, ubos[j], 0, GL_FALSE, 0, GL_WRITE_ONLY | GL_READ_ONLY, iobj->Format);
-					}
-					else if (m_objects->IsImage3D(ubos[j])) {
-						Image3DObject* iobj = m_objects->GetImage3D(m_objects->GetImage3DNameByID(ubos[j]));
-						glBindImageTexture(j, ubos[j], 0, GL_TRUE, 0, GL_WRITE_ONLY | GL_READ_ONLY, iobj->Format);
-					}
-					else if (m_objects->IsPluginObject(ubos[j])) {
-						PluginObject* pobj = m_objects->GetPluginObject(ubos[j]);
-						pobj->Owner->BindObject(pobj->Type, pobj->Data, pobj->ID);
-					} else
-						glBindBufferBase(GL_SHADER_STORAGE_BUFFER, j, ubos[j]);
+				for (int j = 0; j < binds.Buffers.size(); j++) {
+					const ResourceBind& ubo = binds.Buffers[j];
+					if (ubo.Target == GL_TEXTURE_2D)
+						glBindImageTexture(j, ubo.ID, 0, GL_FALSE, 0, GL_WRITE_ONLY | GL_READ_ONLY, ubo.Format);
+					else if (ubo.Target == GL_TEXTURE_3D)
+						glBindImageTexture(j, ubo.ID, 0, GL_TRUE, 0, GL_WRITE_ONLY | GL_READ_ONLY, ubo.Format);
+					else if (ubo.Plugin != nullptr)
+						ubo.Plugin->Owner->BindObject(ubo.Plugin->Type, ubo.Plugin->Data, ubo.Plugin->ID);
+					else
+						glBindBufferBase(GL_SHADER_STORAGE_BUFFER, j, ubo.ID);
 				}
 				
 				// bind variables
+				m_profiler.Mark(PipelineProfiler::Category::Uniforms);
 				data->Variables.Bind();
 
 				// call compute shader
-				glDispatchCompute(data->WorkX, data->WorkY, data->WorkZ);
+				m_profiler.Mark(PipelineProfiler::Category::Draw);
+				if (groupCount > 0) // WorkX < Slices -> some slices are empty
+					glDispatchCompute(groupCount, data->WorkY, data->WorkZ);
 
 				// wait until it finishes
 				glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 				// or maybe until i implement these as options glMemoryBarrier(GL_ALL_BARRIER_BITS);
+
+				for (const ResourceBind& uav : binds.Buffers) {
+					if (uav.Target == GL_TEXTURE_2D || uav.Target == GL_TEXTURE_3D)
+						m_textureVersions[uav.ID]++;
+					else if (uav.Plugin == nullptr)
+						m_bufferVersions[uav.ID]++;
+				}
 			}
 			else if (it->Type == PipelineItem::ItemType::AudioPass && !isDebug) {
 				pipe::AudioPass *data = (pipe::AudioPass *)it->Data;
 
-				const std::vector<GLuint>& srvs = m_objects->GetBindList(m_items[i]);
-				const std::vector<GLuint>& ubos = m_objects->GetUniformBindList(m_items[i]);
+				const BindTable& binds = m_objects->GetBindTable(m_items[i]);
 
 				// bind shader resource views
-				for (int j = 0; j < srvs.size(); j++)
+				for (int j = 0; j < binds.Textures.size(); j++)
 				{
+					const ResourceBind& srv = binds.Textures[j];
 					glActiveTexture(GL_TEXTURE0 + j);
-					if (m_objects->IsCubeMap(srvs[j]))
-						glBindTexture(GL_TEXTURE_CUBE_MAP, srvs[j]);
-					else if (m_objects->IsImage3D(srvs[j]))
-						glBindTexture(GL_TEXTURE_3D, srvs[j]);
-					else if (m_objects->IsPluginObject(srvs[j])) {
-						PluginObject* pobj = m_objects->GetPluginObject(srvs[j]);
-						pobj->Owner->BindObject(pobj->Type, pobj->Data, pobj->ID);
-					}
+					if (srv.Plugin != nullptr)
+						srv.Plugin->Owner->BindObject(srv.Plugin->Type, srv.Plugin->Data, srv.Plugin->ID);
 					else
-						glBindTexture(GL_TEXTURE_2D, srvs[j]);
-
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL) // TODO: or should this be for vulkan glsl too?
-						data->Variables.UpdateTexture(m_shaders[i], j);
+						glBindTexture(srv.Target, srv.ID);
 				}
 
 				// bind buffers
-				for (int j = 0; j < ubos.size(); j++) {
-					if (m_objects->IsBuffer(m_objects->GetBufferNameByID(ubos[j])))
-						glBindBufferBase(GL_SHADER_STORAGE_BUFFER, j, ubos[j]);
+				for (int j = 0; j < binds.Buffers.size(); j++) {
+					if (binds.Buffers[j].Target == GL_SHADER_STORAGE_BUFFER)
+						glBindBufferBase(GL_SHADER_STORAGE_BUFFER, j, binds.Buffers[j].ID);
 				}
 				
 				// bind variables
+				m_profiler.Mark(PipelineProfiler::Category::Uniforms);
 				data->Variables.Bind();
 
+				m_profiler.Mark(PipelineProfiler::Category::Draw);
 				data->Stream.renderAudio();
+
+				for (const ResourceBind& ssbo : binds.Buffers)
+					if (ssbo.Target == GL_SHADER_STORAGE_BUFFER)
+						m_bufferVersions[ssbo.ID]++;
 			}
 			else if (it->Type == PipelineItem::ItemType::PluginItem && !isDebug) {
 				pipe::PluginItemData* pldata = reinterpret_cast<pipe::PluginItemData*>(it->Data);
 
+				m_profiler.Mark(PipelineProfiler::Category::Draw);
 				pldata->Owner->ExecutePipelineItem(pldata->Type, pldata->PluginData, pldata->Items.data(), pldata->Items.size());
 			}
 		}
 
+		m_profiler.EndFrame();
+
 		m_plugins->EndRender();
 
 		// update frame index
@@ -530,9 +628,16 @@ namespace ed
 
 		if (isMSAA)
 			glDisable(GL_MULTISAMPLE);
+
+		if (!isDebug)
+			gl::CallCounter::Instance().EndFrame();
+		else
+			m_passCache.clear(); // debug shaders have overwritten the render textures
 	}
 	void RenderEngine::DebugPixelPick(glm::vec2 r)
 	{
+		TRACE_ZONE("RenderEngine::DebugPixelPick");
+
 		m_debug->ClearPixelList();
 
 		int x = r.x * m_lastSize.x;
@@ -648,6 +753,7 @@ namespace ed
 		}
 
 		// return the actual RT that was shown before
+		m_passCache.clear();
 		Render();
 
 		delete[] mainPixelData;
@@ -664,8 +770,8 @@ namespace ed
 		int lineBias = 0;
 		if (ShaderTranscompiler::GetShaderTypeFromExtension(vertexPass->VSPath) == ShaderLanguage::GLSL) {// GLSL
 			vsCode = m_project->LoadProjectFile(vertexPass->VSPath);
-			m_includeCheck(vsCode, std::vector<std::string>(), lineBias);
-			m_applyMacros(vsCode, vertexPass);
+			m_includeCheck(vsCode, lineBias);
+			ShaderPreprocessor::ApplyMacros(vsCode, vertexPass->Macros);
 		}
 		else // HLSL / VK
 			vsCode = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(vertexPass->VSPath), m_project->GetProjectPath(std::string(vertexPass->VSPath)), 0, vertexPass->VSEntry, vertexPass->Macros, vertexPass->GSUsed, m_msgs, m_project);
@@ -700,11 +806,7 @@ namespace ed
 		vertexPass->Variables.UpdateUniformInfo(customProgram);
 
 		// get resources
-		const std::vector<GLuint>& srvs = m_objects->GetBindList(vertexData);
-		const std::vector<GLuint>& ubos = m_objects->GetUniformBindList(vertexData);
-
-		// item variable values
-		auto& itemVarValues = GetItemVariableValues();
+		const BindTable& binds = m_objects->GetBindTable(vertexData);
 
 		// bind fbo and buffers
 		glBindFramebuffer(GL_FRAMEBUFFER, vertexPass->FBO);
@@ -743,24 +845,16 @@ namespace ed
 		glUseProgram(customProgram);
 
 		// bind shader resource views
-		for (int j = 0; j < srvs.size(); j++) {
+		for (int j = 0; j < binds.Textures.size(); j++) {
+			const ResourceBind& srv = binds.Textures[j];
 			glActiveTexture(GL_TEXTURE0 + j);
-			if (m_objects->IsCubeMap(srvs[j]))
-				glBindTexture(GL_TEXTURE_CUBE_MAP, srvs[j]);
-			else if (m_objects->IsImage3D(srvs[j]))
-				glBindTexture(GL_TEXTURE_3D, srvs[j]);
-			else if (m_objects->IsPluginObject(srvs[j])) {
-				PluginObject* pobj = m_objects->GetPluginObject(srvs[j]);
-				pobj->Owner->BindObject(pobj->Type, pobj->Data, pobj->ID);
-			}
+			if (srv.Plugin != nullptr)
+				srv.Plugin->Owner->BindObject(srv.Plugin->Type, srv.Plugin->Data, srv.Plugin->ID);
 			else
-				glBindTexture(GL_TEXTURE_2D, srvs[j]);
-
-			if (ShaderTranscompiler::GetShaderTypeFromExtension(vertexPass->PSPath) == ShaderLanguage::GLSL) // TODO: or should this be for vulkan glsl too?
-				vertexPass->Variables.UpdateTexture(customProgram, j);
+				glBindTexture(srv.Target, srv.ID);
 		}
-		for (int j = 0; j < ubos.size(); j++)
-			glBindBufferBase(GL_UNIFORM_BUFFER, j, ubos[j]);
+		for (int j = 0; j < binds.Buffers.size(); j++)
+			glBindBufferBase(GL_UNIFORM_BUFFER, j, binds.Buffers[j].ID);
 
 		// bind default states for each shader pass
 		DefaultState::Bind();
@@ -774,9 +868,6 @@ namespace ed
 			if (item->Type == PipelineItem::ItemType::Geometry || item->Type == PipelineItem::ItemType::Model) {
 				if (item != vertexItem)
 					continue;
-				for (int k = 0; k < itemVarValues.size(); k++)
-					if (itemVarValues[k].Item == item)
-						itemVarValues[k].Variable->Data = itemVarValues[k].NewValue->Data;
 			}
 
 			if (item->Type == PipelineItem::ItemType::Geometry) {
@@ -823,12 +914,6 @@ namespace ed
 				glCullFace(state->CullFaceType);
 				glFrontFace(state->FrontFace);
 			}
-
-			// set the old value back
-			if (item->Type == PipelineItem::ItemType::Geometry || item->Type == PipelineItem::ItemType::Model)
-				for (int k = 0; k < itemVarValues.size(); k++)
-					if (itemVarValues[k].Item == item)
-						itemVarValues[k].Variable->Data = itemVarValues[k].OldValue;
 		}
 
 		// window pixel color
@@ -850,6 +935,7 @@ namespace ed
 		}
 
 		// return the actual RT that was shown before
+		m_passCache.clear();
 		Render();
 
 		glDeleteProgram(customProgram);
@@ -869,8 +955,8 @@ namespace ed
 		int lineBias = 0;
 		if (ShaderTranscompiler::GetShaderTypeFromExtension(vertexPass->VSPath) == ShaderLanguage::GLSL) {// GLSL
 			vsCode = m_project->LoadProjectFile(vertexPass->VSPath);
-			m_includeCheck(vsCode, std::vector<std::string>(), lineBias);
-			m_applyMacros(vsCode, vertexPass);
+			m_includeCheck(vsCode, lineBias);
+			ShaderPreprocessor::ApplyMacros(vsCode, vertexPass->Macros);
 		}
 		else // HLSL / VK
 			vsCode = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(vertexPass->VSPath), m_project->GetProjectPath(std::string(vertexPass->VSPath)), 0, vertexPass->VSEntry, vertexPass->Macros, vertexPass->GSUsed, m_msgs, m_project);
@@ -905,11 +991,7 @@ namespace ed
 		vertexPass->Variables.UpdateUniformInfo(customProgram);
 
 		// get resources
-		const std::vector<GLuint>& srvs = m_objects->GetBindList(vertexData);
-		const std::vector<GLuint>& ubos = m_objects->GetUniformBindList(vertexData);
-
-		// item variable values
-		auto& itemVarValues = GetItemVariableValues();
+		const BindTable& binds = m_objects->GetBindTable(vertexData);
 
 		// bind fbo and buffers
 		glBindFramebuffer(GL_FRAMEBUFFER, vertexPass->FBO);
@@ -948,24 +1030,16 @@ namespace ed
 		glUseProgram(customProgram);
 
 		// bind shader resource views
-		for (int j = 0; j < srvs.size(); j++) {
+		for (int j = 0; j < binds.Textures.size(); j++) {
+			const ResourceBind& srv = binds.Textures[j];
 			glActiveTexture(GL_TEXTURE0 + j);
-			if (m_objects->IsCubeMap(srvs[j]))
-				glBindTexture(GL_TEXTURE_CUBE_MAP, srvs[j]);
-			else if (m_objects->IsImage3D(srvs[j]))
-				glBindTexture(GL_TEXTURE_3D, srvs[j]);
-			else if (m_objects->IsPluginObject(srvs[j])) {
-				PluginObject* pobj = m_objects->GetPluginObject(srvs[j]);
-				pobj->Owner->BindObject(pobj->Type, pobj->Data, pobj->ID);
-			}
+			if (srv.Plugin != nullptr)
+				srv.Plugin->Owner->BindObject(srv.Plugin->Type, srv.Plugin->Data, srv.Plugin->ID);
 			else
-				glBindTexture(GL_TEXTURE_2D, srvs[j]);
-
-			if (ShaderTranscompiler::GetShaderTypeFromExtension(vertexPass->PSPath) == ShaderLanguage::GLSL) // TODO: or should this be for vulkan glsl too?
-				vertexPass->Variables.UpdateTexture(customProgram, j);
+				glBindTexture(srv.Target, srv.ID);
 		}
-		for (int j = 0; j < ubos.size(); j++)
-			glBindBufferBase(GL_UNIFORM_BUFFER, j, ubos[j]);
+		for (int j = 0; j < binds.Buffers.size(); j++)
+			glBindBufferBase(GL_UNIFORM_BUFFER, j, binds.Buffers[j].ID);
 
 		// bind default states for each shader pass
 		DefaultState::Bind();
@@ -979,9 +1053,6 @@ namespace ed
 			if (item->Type == PipelineItem::ItemType::Geometry || item->Type == PipelineItem::ItemType::Model) {
 				if (item != vertexItem)
 					continue;
-				for (int k = 0; k < itemVarValues.size(); k++)
-					if (itemVarValues[k].Item == item)
-						itemVarValues[k].Variable->Data = itemVarValues[k].NewValue->Data;
 			}
 
 			if (item->Type == PipelineItem::ItemType::Geometry) {
@@ -1028,12 +1099,6 @@ namespace ed
 				glCullFace(state->CullFaceType);
 				glFrontFace(state->FrontFace);
 			}
-
-			// set the old value back
-			if (item->Type == PipelineItem::ItemType::Geometry || item->Type == PipelineItem::ItemType::Model)
-				for (int k = 0; k < itemVarValues.size(); k++)
-					if (itemVarValues[k].Item == item)
-						itemVarValues[k].Variable->Data = itemVarValues[k].OldValue;
 		}
 
 		// window pixel color
@@ -1055,6 +1120,7 @@ namespace ed
 		}
 
 		// return the actual RT that was shown before
+		m_passCache.clear();
 		Render();
 
 		glDeleteProgram(customProgram);
@@ -1073,8 +1139,57 @@ namespace ed
 
 		m_debug->ClearPixelList();
 	}
+	void RenderEngine::AddItemVariableValue(const ItemVariableValue& item)
+	{
+		m_itemValues.push_back(item);
+
+		ShaderVariableContainer* vars = m_getItemValueContainer(item.Item);
+		if (vars != nullptr)
+			vars->SetItemValue(item.Item, item.Variable, item.NewValue);
+	}
+	void RenderEngine::RemoveItemVariableValue(PipelineItem* item, ShaderVariable* var)
+	{
+		for (int i = 0; i < m_itemValues.size(); i++)
+			if (m_itemValues[i].Item == item && m_itemValues[i].Variable == var) {
+				m_itemValues.erase(m_itemValues.begin() + i);
+				break;
+			}
+
+		ShaderVariableContainer* vars = m_getItemValueContainer(item);
+		if (vars != nullptr)
+			vars->RemoveItemValue(item, var);
+	}
+	void RenderEngine::RemoveItemVariableValues(PipelineItem* item)
+	{
+		for (int i = 0; i < m_itemValues.size(); i++)
+			if (m_itemValues[i].Item == item) {
+				m_itemValues.erase(m_itemValues.begin() + i);
+				i--;
+			}
+
+		ShaderVariableContainer* vars = m_getItemValueContainer(item);
+		if (vars != nullptr)
+			vars->RemoveItemValues(item);
+	}
+	ShaderVariableContainer* RenderEngine::m_getItemValueContainer(PipelineItem* item)
+	{
+		if (item == nullptr)
+			return nullptr;
+
+		const char* ownerName = m_pipeline->GetItemOwner(item->Name);
+		if (ownerName == nullptr)
+			return nullptr;
+
+		PipelineItem* owner = m_pipeline->Get(ownerName);
+		if (owner == nullptr)
+			return nullptr;
+
+		return &((pipe::ShaderPass*)owner->Data)->Variables;
+	}
 	void RenderEngine::Recompile(const char * name)
 	{
+		TRACE_ZONE("RenderEngine::Recompile");
+
 		Logger::Get().Log("Recompiling " + std::string(name)); 
 
 		m_msgs->BuildOccured = true;
@@ -1086,6 +1201,9 @@ namespace ed
 		for (int i = 0; i < m_items.size(); i++) {
 			PipelineItem* item = m_items[i];
 			if (strcmp(item->Name, name) == 0) {
+				m_passCache.erase(item);
+				m_unslicedPasses.erase(item);
+
 				if (item->Type == PipelineItem::ItemType::ShaderPass) {
 					pipe::ShaderPass* shader = (pipe::ShaderPass*)item->Data;
 
@@ -1104,8 +1222,8 @@ namespace ed
 					m_msgs->CurrentItemType = 1;
 					if (ShaderTranscompiler::GetShaderTypeFromExtension(shader->PSPath) == ShaderLanguage::GLSL) {// GLSL
 						psContent = m_project->LoadProjectFile(shader->PSPath);
-						m_includeCheck(psContent, std::vector<std::string>(), lineBias);
-						m_applyMacros(psContent, shader);
+						m_includeCheck(psContent, lineBias);
+						ShaderPreprocessor::ApplyMacros(psContent, shader->Macros);
 					} else { // HLSL / VK
 						psContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(shader->PSPath), m_project->GetProjectPath(std::string(shader->PSPath)), 1, shader->PSEntry, shader->Macros, shader->GSUsed, m_msgs, m_project);
 						psEntry = "main";
@@ -1123,8 +1241,8 @@ namespace ed
 					lineBias = 0;
 					if (ShaderTranscompiler::GetShaderTypeFromExtension(shader->VSPath) == ShaderLanguage::GLSL) {// GLSL
 						vsContent = m_project->LoadProjectFile(shader->VSPath);
-						m_includeCheck(vsContent, std::vector<std::string>(), lineBias);
-						m_applyMacros(vsContent, shader);
+						m_includeCheck(vsContent, lineBias);
+						ShaderPreprocessor::ApplyMacros(vsContent, shader->Macros);
 					} else { // HLSL / VK
 						vsContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(shader->VSPath), m_project->GetProjectPath(std::string(shader->VSPath)), 0, shader->VSEntry, shader->Macros, shader->GSUsed, m_msgs, m_project);
 						vsEntry = "main";
@@ -1147,8 +1265,8 @@ namespace ed
 						lineBias = 0;
 						if (ShaderTranscompiler::GetShaderTypeFromExtension(shader->GSPath) == ShaderLanguage::GLSL) {// GLSL
 							gsContent = m_project->LoadProjectFile(shader->GSPath);
-							m_includeCheck(gsContent, std::vector<std::string>(), lineBias);
-							m_applyMacros(gsContent, shader);
+							m_includeCheck(gsContent, lineBias);
+							ShaderPreprocessor::ApplyMacros(gsContent, shader->Macros);
 						} else { // HLSL / VK
 							gsContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(shader->GSPath), m_project->GetProjectPath(std::string(shader->GSPath)), 2, shader->GSEntry, shader->Macros, shader->GSUsed, m_msgs, m_project);
 							gsEntry = "main";
@@ -1201,8 +1319,8 @@ namespace ed
 					m_msgs->CurrentItemType = 3;
 					if (ShaderTranscompiler::GetShaderTypeFromExtension(shader->Path) == ShaderLanguage::GLSL) {// GLSL
 						content = m_project->LoadProjectFile(shader->Path);
-						m_includeCheck(content, std::vector<std::string>(), lineBias);
-						m_applyMacros(content, shader);
+						m_includeCheck(content, lineBias);
+						ShaderPreprocessor::ApplyMacros(content, shader->Macros);
 					} else { // HLSL / VK
 						content = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(shader->Path), m_project->GetProjectPath(std::string(shader->Path)), 3, entry, shader->Macros, false, m_msgs, m_project);
 						entry = "main";
@@ -1245,7 +1363,7 @@ namespace ed
 					// compute shader
 					m_msgs->CurrentItemType = 1;
 					if (ShaderTranscompiler::GetShaderTypeFromExtension(shader->Path) == ShaderLanguage::GLSL)
-						m_applyMacros(content, shader);
+						ShaderPreprocessor::ApplyMacros(content, shader->Macros);
 					
 					shader->Stream.compileFromShaderSource(m_project, m_msgs, content, shader->Macros, ShaderTranscompiler::GetShaderTypeFromExtension(shader->Path) == ShaderLanguage::HLSL);
 					shader->Variables.UpdateUniformInfo(shader->Stream.getShader());
@@ -1287,6 +1405,8 @@ namespace ed
 	}
 	void RenderEngine::RecompileFromSource(const char* name, const std::string& vssrc, const std::string& pssrc, const std::string& gssrc)
 	{
+		TRACE_ZONE("RenderEngine::RecompileFromSource");
+
 		m_msgs->BuildOccured = true;
 		m_msgs->CurrentItem = name;
 
@@ -1296,6 +1416,9 @@ namespace ed
 		for (int i = 0; i < m_items.size(); i++) {
 			PipelineItem* item = m_items[i];
 			if (strcmp(item->Name, name) == 0) {
+				m_passCache.erase(item);
+				m_unslicedPasses.erase(item);
+
 				if (item->Type == PipelineItem::ItemType::ShaderPass) {
 					pipe::ShaderPass* shader = (pipe::ShaderPass*)item->Data;
 					m_msgs->ClearGroup(name);
@@ -1629,6 +1752,7 @@ namespace ed
 	{
 		for (int i = 0; i < m_shaders.size(); i++) {
 			glDeleteProgram(m_shaders[i]);
+			glDeleteProgram(m_debugShaders[i]);
 			glDeleteShader(m_shaderSources[i].VS);
 			glDeleteShader(m_shaderSources[i].PS);
 			glDeleteShader(m_shaderSources[i].GS);
@@ -1638,8 +1762,15 @@ namespace ed
 		m_fboCount.clear();
 		m_items.clear();
 		m_shaders.clear();
+		m_debugShaders.clear();
 		m_shaderSources.clear();
+		m_passCache.clear();
+		m_passSchedule.clear();
+		m_unslicedPasses.clear();
 		m_fbosNeedUpdate = true;
+		m_cacheRebuild = true;
+
+		m_profiler.Reset();
 
 		// clear textures
 		glBindTexture(GL_TEXTURE_2D, m_rtColor);
@@ -1652,305 +1783,301 @@ namespace ed
 	}
 	void RenderEngine::m_cache()
 	{
-		// check for any changes
+		std::vector<PipelineEvent> events;
+		m_pipeline->PollEvents(events);
+
 		std::vector<ed::PipelineItem*>& items = m_pipeline->GetList();
 
-		// check if no major changes were made, if so dont cache for another 0.25s
-		if (m_items.size() == items.size()) {
-			if (m_cacheTimer.GetElapsedTime() > 0.5f)
-				m_cacheTimer.Restart();
-			else return;
+		// FlushCache() was called -> cache the whole list, the events are already included in it
+		if (m_cacheRebuild) {
+			for (PipelineItem* item : items)
+				m_cacheItem(item);
+			m_cacheRebuild = false;
+			return;
 		}
 
-		GLchar cMsg[1024];
-
-		// check if some item was added
-		for (int i = 0; i < items.size(); i++) {
-			bool found = false;
-			for (int j = 0; j < m_items.size(); j++)
-				if (items[i]->Data == m_items[j]->Data) {
-					found = true;
-					break;
-				}
-
-			if (!found) {
-				Logger::Get().Log("Caching a new shader pass " + std::string(items[i]->Name));
-
-				if (items[i]->Type == PipelineItem::ItemType::ShaderPass) {
-					pipe::ShaderPass* data = reinterpret_cast<ed::pipe::ShaderPass*>(items[i]->Data);
-
-					m_items.insert(m_items.begin() + i, items[i]);
-					m_shaders.insert(m_shaders.begin() + i, 0);
-					m_debugShaders.insert(m_debugShaders.begin() + i, 0);
-					m_shaderSources.insert(m_shaderSources.begin() + i, ShaderPack());
-
-					if (strlen(data->VSPath) == 0 || strlen(data->PSPath) == 0) {
-						Logger::Get().Log("No shader paths are set", true);
-						continue;
-					}
-
-					if (m_shaderSources[i].VS != 0) glDeleteShader(m_shaderSources[i].VS);
-					if (m_shaderSources[i].PS != 0) glDeleteShader(m_shaderSources[i].PS);
-					if (m_shaderSources[i].GS != 0) glDeleteShader(m_shaderSources[i].GS);
-
-					/*
-						ITEM CACHING
-					*/
-
-					m_fbos[data].resize(MAX_RENDER_TEXTURES);
-
-					GLuint ps = 0, vs = 0, gs = 0;
+		bool reorder = false;
+		for (const PipelineEvent& e : events) {
+			if (e.Owner != nullptr) { // items inside of the passes aren't cached, only profiled
+				if (e.Type == PipelineEvent::EventType::Remove)
+					m_profiler.RemoveItem(e.Item);
+				continue;
+			}
 
-					m_msgs->CurrentItem = items[i]->Name;
+			if (e.Type == PipelineEvent::EventType::Add) {
+				// the item might've been removed after it was added
+				if (std::count(items.begin(), items.end(), e.Item) == 0 || std::count(m_items.begin(), m_items.end(), e.Item) > 0)
+					continue;
 
-					std::string psContent = "", vsContent = "",
-						vsEntry = data->VSEntry,
-						psEntry = data->PSEntry;
-					int lineBias = 0;
+				m_cacheItem(e.Item);
+				reorder = true;
+			}
+			else if (e.Type == PipelineEvent::EventType::Remove)
+				m_uncacheItem(e.Item, e.Data);
+			else if (e.Type == PipelineEvent::EventType::Move)
+				reorder = true;
+		}
 
-					// vertex shader
-					m_msgs->CurrentItemType = 0;
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->VSPath) == ShaderLanguage::GLSL) { // GLSL
-						vsContent = m_project->LoadProjectFile(data->VSPath);
-						m_includeCheck(vsContent, std::vector<std::string>(), lineBias);
-						m_applyMacros(vsContent, data);
-					} else { // HLSL / VK
-						vsContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->VSPath), m_project->GetProjectPath(std::string(data->VSPath)), 0, data->VSEntry, data->Macros, data->GSUsed, m_msgs, m_project);
-						vsEntry = "main";
-					}
-					
-					vs = gl::CompileShader(GL_VERTEX_SHADER, vsContent.c_str());
-					bool vsCompiled = gl::CheckShaderCompilationStatus(vs, cMsg);
+		// new items are added to the end of the cache
+		if (reorder) {
+			std::vector<PipelineItem*> cItems;
+			std::vector<GLuint> cShaders, cDebugShaders;
+			std::vector<ShaderPack> cShaderSources;
+			for (PipelineItem* item : items) {
+				int index = std::find(m_items.begin(), m_items.end(), item) - m_items.begin();
+				if (index == m_items.size())
+					continue;
 
-					if (!vsCompiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->VSPath) == ShaderLanguage::GLSL)
-						m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 0, cMsg, lineBias));
+				cItems.push_back(m_items[index]);
+				cShaders.push_back(m_shaders[index]);
+				cDebugShaders.push_back(m_debugShaders[index]);
+				cShaderSources.push_back(m_shaderSources[index]);
+			}
 
-					// pixel shader
-					m_msgs->CurrentItemType = 1;
-					lineBias = 0;
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath) == ShaderLanguage::GLSL) { // GLSL
-						psContent = m_project->LoadProjectFile(data->PSPath);
-						m_includeCheck(psContent, std::vector<std::string>(), lineBias);
-						m_applyMacros(psContent, data);
-					} else { // HLSL / VK
-						psContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath), m_project->GetProjectPath(std::string(data->PSPath)), 1, data->PSEntry, data->Macros, data->GSUsed, m_msgs, m_project);
-						psEntry = "main";
-					}
+			m_items.swap(cItems);
+			m_shaders.swap(cShaders);
+			m_debugShaders.swap(cDebugShaders);
+			m_shaderSources.swap(cShaderSources);
+		}
+	}
+	void RenderEngine::m_cacheItem(PipelineItem* item)
+	{
+		// compute shaders aren't cached (and won't be executed) if they aren't supported
+		if (item->Type == PipelineItem::ItemType::ComputePass && !m_computeSupported)
+			return;
 
-					data->Variables.UpdateTextureList(psContent);
-					ps = gl::CompileShader(GL_FRAGMENT_SHADER, psContent.c_str());
-					bool psCompiled = gl::CheckShaderCompilationStatus(ps, cMsg);
+		Logger::Get().Log("Caching a new pipeline item " + std::string(item->Name));
 
-					if (!psCompiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath) == ShaderLanguage::GLSL)
-						m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 1, cMsg, lineBias));
+		m_passCache.erase(item);
 
-					// geometry shader
-					lineBias = 0;
-					bool gsCompiled = true;
-					if (data->GSUsed && strlen(data->GSEntry) > 0 && strlen(data->GSPath) > 0) {
-						std::string gsContent = "", gsEntry = data->GSEntry;
-						m_msgs->CurrentItemType = 2;
-						if (ShaderTranscompiler::GetShaderTypeFromExtension(data->GSPath) == ShaderLanguage::GLSL) { // GLSL
-							gsContent = m_project->LoadProjectFile(data->GSPath);
-							m_includeCheck(gsContent, std::vector<std::string>(), lineBias);
-							m_applyMacros(gsContent, data);
-						} else { // HLSL
-							gsContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->GSPath), m_project->GetProjectPath(std::string(data->GSPath)), 2, data->GSEntry, data->Macros, data->GSUsed, m_msgs, m_project);
-							gsEntry = "main";
-							
-							m_msgs->Add(MessageStack::Type::Warning, m_msgs->CurrentItem, "Geometry shaders are currently not supported by glslang");
-						}
+		// every cached item has an entry in each of these lists
+		int i = m_items.size();
+		m_items.push_back(item);
+		m_shaders.push_back(0);
+		m_debugShaders.push_back(0);
+		m_shaderSources.push_back(ShaderPack());
 
-						gs = gl::CompileShader(GL_GEOMETRY_SHADER, gsContent.c_str());
-						gsCompiled = gl::CheckShaderCompilationStatus(gs, cMsg);
+		GLchar cMsg[1024];
 
-						if (!gsCompiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->GSPath) == ShaderLanguage::GLSL)
-							m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 2, cMsg, lineBias));
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* data = reinterpret_cast<ed::pipe::ShaderPass*>(item->Data);
 
-					}
+			if (strlen(data->VSPath) == 0 || strlen(data->PSPath) == 0) {
+				Logger::Get().Log("No shader paths are set", true);
+				return;
+			}
 
-					if (m_shaders[i] != 0)
-						glDeleteProgram(m_shaders[i]);
+			/*
+				ITEM CACHING
+			*/
 
-					if (m_debugShaders[i] != 0)
-						glDeleteProgram(m_debugShaders[i]);
+			m_fbos[data].resize(MAX_RENDER_TEXTURES);
 
-					if (!vsCompiled || !psCompiled || !gsCompiled) {
-						m_msgs->Add(MessageStack::Type::Error, items[i]->Name, "Failed to compile the shader");
-						m_shaders[i] = 0;
-					} else {
-						m_msgs->ClearGroup(items[i]->Name);
+			GLuint ps = 0, vs = 0, gs = 0;
 
-						m_shaders[i] = glCreateProgram();
-						glAttachShader(m_shaders[i], vs);
-						glAttachShader(m_shaders[i], ps);
-						if (data->GSUsed) glAttachShader(m_shaders[i], gs);
-						glLinkProgram(m_shaders[i]);
+			m_msgs->CurrentItem = item->Name;
 
-						m_debugShaders[i] = glCreateProgram();
-						glAttachShader(m_debugShaders[i], m_debugPixelShader);
-						glAttachShader(m_debugShaders[i], vs);
-						glLinkProgram(m_debugShaders[i]);
-					}
+			std::string psContent = "", vsContent = "",
+				vsEntry = data->VSEntry,
+				psEntry = data->PSEntry;
+			int lineBias = 0;
 
-					if (m_shaders[i] != 0)
-						data->Variables.UpdateUniformInfo(m_shaders[i]);
+			// vertex shader
+			m_msgs->CurrentItemType = 0;
+			if (ShaderTranscompiler::GetShaderTypeFromExtension(data->VSPath) == ShaderLanguage::GLSL) { // GLSL
+				vsContent = m_project->LoadProjectFile(data->VSPath);
+				m_includeCheck(vsContent, lineBias);
+				ShaderPreprocessor::ApplyMacros(vsContent, data->Macros);
+			} else { // HLSL / VK
+				vsContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->VSPath), m_project->GetProjectPath(std::string(data->VSPath)), 0, data->VSEntry, data->Macros, data->GSUsed, m_msgs, m_project);
+				vsEntry = "main";
+			}
+			
+			vs = gl::CompileShader(GL_VERTEX_SHADER, vsContent.c_str());
+			bool vsCompiled = gl::CheckShaderCompilationStatus(vs, cMsg);
+
+			if (!vsCompiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->VSPath) == ShaderLanguage::GLSL)
+				m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 0, cMsg, lineBias));
+
+			// pixel shader
+			m_msgs->CurrentItemType = 1;
+			lineBias = 0;
+			if (ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath) == ShaderLanguage::GLSL) { // GLSL
+				psContent = m_project->LoadProjectFile(data->PSPath);
+				m_includeCheck(psContent, lineBias);
+				ShaderPreprocessor::ApplyMacros(psContent, data->Macros);
+			} else { // HLSL / VK
+				psContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath), m_project->GetProjectPath(std::string(data->PSPath)), 1, data->PSEntry, data->Macros, data->GSUsed, m_msgs, m_project);
+				psEntry = "main";
+			}
 
-					m_shaderSources[i].VS = vs;
-					m_shaderSources[i].PS = ps;
-					m_shaderSources[i].GS = gs;
-				} 
-				else if (items[i]->Type == PipelineItem::ItemType::ComputePass && m_computeSupported) {
-					pipe::ComputePass *data = reinterpret_cast<ed::pipe::ComputePass *>(items[i]->Data);
+			data->Variables.UpdateTextureList(psContent);
+			ps = gl::CompileShader(GL_FRAGMENT_SHADER, psContent.c_str());
+			bool psCompiled = gl::CheckShaderCompilationStatus(ps, cMsg);
+
+			if (!psCompiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->PSPath) == ShaderLanguage::GLSL)
+				m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 1, cMsg, lineBias));
+
+			// geometry shader
+			lineBias = 0;
+			bool gsCompiled = true;
+			if (data->GSUsed && strlen(data->GSEntry) > 0 && strlen(data->GSPath) > 0) {
+				std::string gsContent = "", gsEntry = data->GSEntry;
+				m_msgs->CurrentItemType = 2;
+				if (ShaderTranscompiler::GetShaderTypeFromExtension(data->GSPath) == ShaderLanguage::GLSL) { // GLSL
+					gsContent = m_project->LoadProjectFile(data->GSPath);
+					m_includeCheck(gsContent, lineBias);
+					ShaderPreprocessor::ApplyMacros(gsContent, data->Macros);
+				} else { // HLSL
+					gsContent = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->GSPath), m_project->GetProjectPath(std::string(data->GSPath)), 2, data->GSEntry, data->Macros, data->GSUsed, m_msgs, m_project);
+					gsEntry = "main";
+					
+					m_msgs->Add(MessageStack::Type::Warning, m_msgs->CurrentItem, "Geometry shaders are currently not supported by glslang");
+				}
 
-					m_items.insert(m_items.begin() + i, items[i]);
-					m_shaders.insert(m_shaders.begin() + i, 0);
-					m_shaderSources.insert(m_shaderSources.begin() + i, ShaderPack());
+				gs = gl::CompileShader(GL_GEOMETRY_SHADER, gsContent.c_str());
+				gsCompiled = gl::CheckShaderCompilationStatus(gs, cMsg);
 
-					if (strlen(data->Path) == 0) {
-						Logger::Get().Log("No shader paths are set", true);
-						continue;
-					}
+				if (!gsCompiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->GSPath) == ShaderLanguage::GLSL)
+					m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 2, cMsg, lineBias));
 
-					/*
-						ITEM CACHING
-					*/
+			}
 
-					GLuint cs = 0;
+			if (m_shaders[i] != 0)
+				glDeleteProgram(m_shaders[i]);
 
-					m_msgs->CurrentItem = items[i]->Name;
+			if (m_debugShaders[i] != 0)
+				glDeleteProgram(m_debugShaders[i]);
 
-					std::string content = "", entry = data->Entry;
-					int lineBias = 0;
+			if (!vsCompiled || !psCompiled || !gsCompiled) {
+				m_msgs->Add(MessageStack::Type::Error, item->Name, "Failed to compile the shader");
+				m_shaders[i] = 0;
+			} else {
+				m_msgs->ClearGroup(item->Name);
+
+				m_shaders[i] = glCreateProgram();
+				glAttachShader(m_shaders[i], vs);
+				glAttachShader(m_shaders[i], ps);
+				if (data->GSUsed) glAttachShader(m_shaders[i], gs);
+				glLinkProgram(m_shaders[i]);
+
+				m_debugShaders[i] = glCreateProgram();
+				glAttachShader(m_debugShaders[i], m_debugPixelShader);
+				glAttachShader(m_debugShaders[i], vs);
+				glLinkProgram(m_debugShaders[i]);
+			}
 
-					// vertex shader
-					m_msgs->CurrentItemType = 3;
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL) { // GLSL
-						content = m_project->LoadProjectFile(data->Path);
-						m_includeCheck(content, std::vector<std::string>(), lineBias);
-						m_applyMacros(content, data);
-					} else { // HLSL / VK
-						content = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->Path), m_project->GetProjectPath(std::string(data->Path)), 3, entry, data->Macros, false, m_msgs, m_project);
-						entry = "main";
-					}
+			if (m_shaders[i] != 0)
+				data->Variables.UpdateUniformInfo(m_shaders[i]);
 
-					cs = gl::CompileShader(GL_COMPUTE_SHADER, content.c_str());
-					bool compiled = gl::CheckShaderCompilationStatus(cs, cMsg);
+			m_shaderSources[i].VS = vs;
+			m_shaderSources[i].PS = ps;
+			m_shaderSources[i].GS = gs;
+		} 
+		else if (item->Type == PipelineItem::ItemType::ComputePass) {
+			pipe::ComputePass *data = reinterpret_cast<ed::pipe::ComputePass *>(item->Data);
 
-					if (!compiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL)
-						m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 3, cMsg, lineBias));
+			if (strlen(data->Path) == 0) {
+				Logger::Get().Log("No shader paths are set", true);
+				return;
+			}
 
-					if (m_shaders[i] != 0)
-						glDeleteProgram(m_shaders[i]);
+			/*
+				ITEM CACHING
+			*/
 
-					if (!compiled)
-					{
-						m_msgs->Add(MessageStack::Type::Error, items[i]->Name, "Failed to compile the compute shader");
-						m_shaders[i] = 0;
-					}
-					else
-					{
-						m_msgs->ClearGroup(items[i]->Name);
+			GLuint cs = 0;
 
-						m_shaders[i] = glCreateProgram();
-						glAttachShader(m_shaders[i], cs);
-						glLinkProgram(m_shaders[i]);
-					}
+			m_msgs->CurrentItem = item->Name;
 
-					if (m_shaders[i] != 0)
-						data->Variables.UpdateUniformInfo(m_shaders[i]);
+			std::string content = "", entry = data->Entry;
+			int lineBias = 0;
 
-					m_shaderSources[i].VS = 0;
-					m_shaderSources[i].PS = 0;
-					m_shaderSources[i].GS = 0;
-				} 
-				else if (items[i]->Type == PipelineItem::ItemType::AudioPass) {
-					pipe::AudioPass *data = reinterpret_cast<ed::pipe::AudioPass *>(items[i]->Data);
+			// vertex shader
+			m_msgs->CurrentItemType = 3;
+			if (ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL) { // GLSL
+				content = m_project->LoadProjectFile(data->Path);
+				m_includeCheck(content, lineBias);
+				ShaderPreprocessor::ApplyMacros(content, data->Macros);
+			} else { // HLSL / VK
+				content = ShaderTranscompiler::Transcompile(ShaderTranscompiler::GetShaderTypeFromExtension(data->Path), m_project->GetProjectPath(std::string(data->Path)), 3, entry, data->Macros, false, m_msgs, m_project);
+				entry = "main";
+			}
 
-					m_items.insert(m_items.begin() + i, items[i]);
-					m_shaders.insert(m_shaders.begin() + i, 0);
-					m_shaderSources.insert(m_shaderSources.begin() + i, ShaderPack());
+			cs = gl::CompileShader(GL_COMPUTE_SHADER, content.c_str());
+			bool compiled = gl::CheckShaderCompilationStatus(cs, cMsg);
 
-					/*
-						ITEM CACHING
-					*/
+			if (!compiled && ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL)
+				m_msgs->Add(gl::ParseMessages(m_msgs->CurrentItem, 3, cMsg, lineBias));
 
-					m_msgs->CurrentItem = items[i]->Name;
-					std::string content = m_project->LoadProjectFile(data->Path);
+			if (m_shaders[i] != 0)
+				glDeleteProgram(m_shaders[i]);
 
-					// vertex shader
-					m_msgs->CurrentItemType = 1;
-					if (ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL)
-						m_applyMacros(content, data);
-					data->Stream.compileFromShaderSource(m_project, m_msgs, content, data->Macros, ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::HLSL);
-						
-					data->Variables.UpdateUniformInfo(data->Stream.getShader());
-				}
-				else if (items[i]->Type == PipelineItem::ItemType::PluginItem) {
-					pipe::PluginItemData *data = reinterpret_cast<pipe::PluginItemData*>(items[i]->Data);
+			if (!compiled)
+			{
+				m_msgs->Add(MessageStack::Type::Error, item->Name, "Failed to compile the compute shader");
+				m_shaders[i] = 0;
+			}
+			else
+			{
+				m_msgs->ClearGroup(item->Name);
 
-					m_items.insert(m_items.begin() + i, items[i]);
-					m_shaders.insert(m_shaders.begin() + i, 0);
-					m_shaderSources.insert(m_shaderSources.begin() + i, ShaderPack());
-				}
+				m_shaders[i] = glCreateProgram();
+				glAttachShader(m_shaders[i], cs);
+				glLinkProgram(m_shaders[i]);
 			}
-		}
 
-		// check if some item was removed
-		for (int i = 0; i < m_items.size(); i++) {
-			bool found = false;
-			for (int j = 0; j < items.size(); j++)
-				if (items[j]->Data == m_items[i]->Data) {
-					found = true;
-					break;
-				}
+			if (m_shaders[i] != 0)
+				data->Variables.UpdateUniformInfo(m_shaders[i]);
 
-			if (!found) {
-				glDeleteProgram(m_shaders[i]);
-				glDeleteProgram(m_debugShaders[i]);
+			m_shaderSources[i].VS = 0;
+			m_shaderSources[i].PS = 0;
+			m_shaderSources[i].GS = 0;
+		} 
+		else if (item->Type == PipelineItem::ItemType::AudioPass) {
+			pipe::AudioPass *data = reinterpret_cast<ed::pipe::AudioPass *>(item->Data);
+
+			/*
+				ITEM CACHING
+			*/
 
-				Logger::Get().Log("Removing an item from cache");
+			m_msgs->CurrentItem = item->Name;
+			std::string content = m_project->LoadProjectFile(data->Path);
 
-				if (m_items[i]->Type == PipelineItem::ItemType::ShaderPass)
-					m_fbos.erase((pipe::ShaderPass*)m_items[i]->Data);
+			// vertex shader
+			m_msgs->CurrentItemType = 1;
+			if (ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::GLSL)
+				ShaderPreprocessor::ApplyMacros(content, data->Macros);
+			data->Stream.compileFromShaderSource(m_project, m_msgs, content, data->Macros, ShaderTranscompiler::GetShaderTypeFromExtension(data->Path) == ShaderLanguage::HLSL);
 				
-				m_items.erase(m_items.begin() + i);
-				m_shaders.erase(m_shaders.begin() + i);
-				m_debugShaders.erase(m_debugShaders.begin() + i);
-				m_shaderSources.erase(m_shaderSources.begin() + i);
-			}
+			data->Variables.UpdateUniformInfo(data->Stream.getShader());
 		}
+	}
+	void RenderEngine::m_uncacheItem(PipelineItem* item, void* data)
+	{
+		int i = std::find(m_items.begin(), m_items.end(), item) - m_items.begin();
+		if (i == m_items.size())
+			return;
 
-		// check if the order of the items changed
-		for (int i = 0; i < m_items.size(); i++) {
-			// two items at the same position dont match
-			if (items[i]->Data != m_items[i]->Data) {
-				// find the real position from original list
-				for (int j = 0; j < items.size(); j++) {
-					// we found the original position so move the item
-					if (items[j]->Data == m_items[i]->Data) {
-						Logger::Get().Log("Updating cached item " + std::string(items[j]->Name));
-
-						int dest = j > i ? (j - 1) : j;
-						m_items.erase(m_items.begin() + i, m_items.begin() + i + 1);
-						m_items.insert(m_items.begin() + dest, items[j]);
-
-						GLuint sCopy = m_shaders[i];
-						GLuint sdbgCopy = m_debugShaders[i];
-						ShaderPack ssrcCopy = m_shaderSources[i];
-						
-						m_shaders.erase(m_shaders.begin() + i);
-						m_shaders.insert(m_shaders.begin() + dest, sCopy);
-
-						m_debugShaders.erase(m_debugShaders.begin() + i);
-						m_debugShaders.insert(m_debugShaders.begin() + dest, sdbgCopy);
-
-						m_shaderSources.erase(m_shaderSources.begin() + i);
-						m_shaderSources.insert(m_shaderSources.begin() + dest, ssrcCopy);
-					}
-				}
-			}
-		}
+		Logger::Get().Log("Removing an item from cache");
+
+		glDeleteProgram(m_shaders[i]);
+		glDeleteProgram(m_debugShaders[i]);
+		glDeleteShader(m_shaderSources[i].VS);
+		glDeleteShader(m_shaderSources[i].PS);
+		glDeleteShader(m_shaderSources[i].GS);
+
+		// the item's data is already freed - only use it as a key
+		m_fbos.erase((pipe::ShaderPass*)data);
+		m_passCache.erase(item);
+		m_passSchedule.erase(item);
+		m_unslicedPasses.erase(item);
+		m_profiler.RemoveItem(item);
+
+		m_items.erase(m_items.begin() + i);
+		m_shaders.erase(m_shaders.begin() + i);
+		m_debugShaders.erase(m_debugShaders.begin() + i);
+		m_shaderSources.erase(m_shaderSources.begin() + i);
 	}
 	bool RenderEngine::m_isGSUsedSet(GLuint rt)
 	{
@@ -1966,109 +2093,27 @@ namespace ed
 
 		return ret;
 	}
-	void RenderEngine::m_applyMacros(std::string  &src, pipe::ShaderPass *pass)
+	void RenderEngine::m_includeCheck(std::string& src, int& lineBias)
 	{
-		size_t verLoc = src.find_first_of("#version");
-		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
-		std::string strMacro = "";
-
-		for (auto &macro : pass->Macros)
-		{
-			if (!macro.Active)
-				continue;
-
-			strMacro += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
-		}
-
-		if (strMacro.size() > 0)
-			src.insert(lineLoc, strMacro);
-	}
-	void RenderEngine::m_applyMacros(std::string  &src, pipe::ComputePass *pass)
-	{
-		size_t verLoc = src.find_first_of("#version");
-		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
-		std::string strMacro = "";
-
-		for (auto &macro : pass->Macros)
-		{
-			if (!macro.Active)
-				continue;
-
-			strMacro += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
-		}
-
-		if (strMacro.size() > 0)
-			src.insert(lineLoc, strMacro);
-	}
-	void RenderEngine::m_applyMacros(std::string  &src, pipe::AudioPass *pass)
-	{
-		size_t verLoc = src.find_first_of("#version");
-		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
-		std::string strMacro = "";
-
-		for (auto &macro : pass->Macros)
-		{
-			if (!macro.Active)
-				continue;
-
-			strMacro += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
-		}
-
-		if (strMacro.size() > 0)
-			src.insert(lineLoc, strMacro);
+		ShaderPreprocessor::ResolveIncludes(src, Settings::Instance().Project.IncludePaths, [&](const std::string& path, std::string& content) -> bool {
+			if (!m_project->FileExists(path))
+				return false;
+			content = m_project->LoadProjectFile(path);
+			return true;
+		}, m_msgs, m_msgs->CurrentItem, lineBias);
 	}
-	void RenderEngine::m_includeCheck(std::string &src, std::vector<std::string> includeStack, int& lineBias)
+	void RenderEngine::m_updateSystemUBO()
 	{
-		size_t incLoc = src.find("#include");
-		Settings& settings = Settings::Instance();
-
-		std::vector<std::string> paths = settings.Project.IncludePaths;
-		paths.push_back(".");
-
-		while (incLoc != std::string::npos) {
-			bool isAfterNewline = true;
-			if (incLoc != 0)
-				if (src[incLoc - 1] != '\n')
-					isAfterNewline = false;
-
-			if (!isAfterNewline) {
-				incLoc = src.find("#include", incLoc + 1);
-				continue;
-			}
-
-			size_t quotePos = src.find_first_of("\"<", incLoc);
-			size_t quoteEnd = src.find_first_of("\">", quotePos + 1);
-			std::string fileName = src.substr(quotePos+1, quoteEnd - quotePos-1);
-
-			for (int i = 0; i < paths.size(); i++) {
-				std::string ipath = paths[i];
-				char last = ipath[ipath.size() - 1];
-				if (last != '\\' && last != '/')
-					ipath += "/";
-
-				ipath += fileName;
+		SystemUniformBlock block;
+		SystemVariableManager::Instance().GetUniformBlock(block);
 
-				src.erase(incLoc, src.find_first_of('\n', incLoc) - incLoc);
-
-				if (std::count(includeStack.begin(), includeStack.end(), ipath) > 0)
-					m_msgs->Add(ed::MessageStack::Type::Error, m_msgs->CurrentItem, "Recursive #include detected");
-
-				if (m_project->FileExists(ipath) && std::count(includeStack.begin(), includeStack.end(), ipath) == 0) {
-					includeStack.push_back(ipath);
-
-					std::string incFileSrc = m_project->LoadProjectFile(ipath);
-					lineBias = std::count(incFileSrc.begin(), incFileSrc.end(), '\n');
-
-					m_includeCheck(incFileSrc, includeStack, lineBias);
-
-					src.insert(incLoc, incFileSrc);
-
-					break;
-				}
-			}
+		if (memcmp(&block, &m_systemBlock, sizeof(block)) == 0)
+			return;
 
-			incLoc = src.find("#include", incLoc + 1);
-		}
+		m_systemBlock = block;
+		glBindBuffer(GL_UNIFORM_BUFFER, m_systemUBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(SystemUniformBlock), &m_systemBlock);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 	void RenderEngine::m_updatePassFBO(ed::pipe::ShaderPass* pass)
 	{
@@ -2089,8 +2134,17 @@ namespace ed
 			return;
 
 		GLuint lastID = pass->RenderTextures[pass->RTCount - 1];
-		GLuint depthID = lastID == m_rtColor ? m_rtDepth : m_objects->GetRenderTexture(lastID)->DepthStencilBuffer;
-		GLuint depthMSID = lastID == m_rtColor ? m_rtDepthMS : m_objects->GetRenderTexture(lastID)->DepthStencilBufferMS;
+		GLuint depthID, depthMSID;
+		if (lastID == m_rtColor) {
+			depthID = m_rtDepth;
+			depthMSID = m_rtDepthMS;
+		} else if (m_rtPool.IsPooled(lastID)) {
+			depthID = m_rtPool.GetDepthStencil(lastID);
+			depthMSID = m_rtPool.GetDepthStencilMS(lastID);
+		} else {
+			depthID = m_objects->GetRenderTexture(lastID)->DepthStencilBuffer;
+			depthMSID = m_objects->GetRenderTexture(lastID)->DepthStencilBufferMS;
+		}
 
 		pass->DepthTexture = depthID;
 
@@ -2125,6 +2179,7 @@ namespace ed
 			if (texID == 0) continue;
 
 			if (texID == m_rtColor) texID = m_rtColorMS;
+			else if (m_rtPool.IsPooled(texID)) texID = m_rtPool.GetColorMS(texID);
 			else texID = m_objects->GetRenderTexture(texID)->BufferMS;
 
 			// attach
@@ -2135,4 +2190,225 @@ namespace ed
 
 		m_fbosNeedUpdate = false;
 	}
+
+	bool RenderEngine::m_isPassCached(int index, int width, int height)
+	{
+		PipelineItem* item = m_items[index];
+
+		bool frozen = false;
+		if (item->Type == PipelineItem::ItemType::ShaderPass)
+			frozen = ((pipe::ShaderPass*)item->Data)->Frozen;
+		else if (item->Type == PipelineItem::ItemType::ComputePass)
+			frozen = ((pipe::ComputePass*)item->Data)->Frozen;
+
+		bool autoCache = Settings::Instance().Preview.CachePasses && item->Type == PipelineItem::ItemType::ShaderPass;
+		if (!frozen && !autoCache)
+			return false;
+
+		PassCache cur;
+		cur.Targets = m_hashPassTargets(index, width, height);
+		cur.Inputs = frozen ? 0 : m_hashPassInputs(index, width, height);
+
+		// frozen passes are only executed again if their targets were recreated
+		auto last = m_passCache.find(item);
+		if (last != m_passCache.end() && last->second.Targets == cur.Targets && (frozen || (cur.Inputs != 0 && last->second.Inputs == cur.Inputs)))
+			return true;
+
+		m_passCache[item] = cur;
+		return false;
+	}
+	uint64_t RenderEngine::m_hashPassTargets(int index, int width, int height)
+	{
+		PipelineItem* item = m_items[index];
+		uint64_t hash = HASH_SEED;
+
+		HashValue(hash, m_shaders[index]);
+
+		if (item->Type == PipelineItem::ItemType::ShaderPass) {
+			pipe::ShaderPass* data = (pipe::ShaderPass*)item->Data;
+
+			HashValue(hash, data->FBO);
+			HashValue(hash, data->RTCount);
+			HashValue(hash, Settings::Instance().Preview.MSAA);
+			for (int i = 0; i < data->RTCount; i++) {
+				GLuint rt = data->RenderTextures[i];
+				HashValue(hash, rt);
+
+				if (rt == m_rtColor)
+					HashValue(hash, glm::ivec2(width, height));
+				else {
+					RenderTextureObject* rtObject = m_objects->GetRenderTexture(rt);
+					HashValue(hash, rtObject->CalculateSize(width, height));
+					HashValue(hash, rtObject->Format);
+				}
+			}
+		} else {
+			const BindTable& binds = m_objects->GetBindTable(item);
+			HashValue(hash, binds.Version);
+			for (const ResourceBind& uav : binds.Buffers)
+				HashValue(hash, uav.ID);
+		}
+
+		return hash;
+	}
+	uint64_t RenderEngine::m_hashPassInputs(int index, int width, int height)
+	{
+		PipelineItem* item = m_items[index];
+		pipe::ShaderPass* data = (pipe::ShaderPass*)item->Data;
+		const BindTable& binds = m_objects->GetBindTable(item);
+
+		// the pass has to be the only one that writes to its render textures and it has to clear them
+		if (!m_graph.IsExclusive(index) || data->Slices > 1)
+			return 0;
+
+		uint64_t hash = HASH_SEED;
+		glm::vec2 rtSize(width, height);
+		for (int i = 0; i < data->RTCount; i++) {
+			GLuint rt = data->RenderTextures[i];
+			if (rt == m_rtColor) {
+				HashValue(hash, Settings::Instance().Project.ClearColor);
+				continue;
+			}
+
+			RenderTextureObject* rtObject = m_objects->GetRenderTexture(rt);
+			if (!rtObject->Clear)
+				return 0;
+
+			rtSize = rtObject->CalculateSize(width, height);
+			HashValue(hash, rtObject->ClearColor);
+		}
+
+		// bound resources and the last time they were written to
+		HashValue(hash, binds.Version);
+		for (const ResourceBind& srv : binds.Textures) {
+			if (srv.Plugin != nullptr || srv.Dynamic)
+				return 0;
+
+			HashValue(hash, srv.ID);
+			HashValue(hash, m_textureVersions[srv.ID]);
+		}
+		for (const ResourceBind& ubo : binds.Buffers) {
+			HashValue(hash, ubo.ID);
+			HashValue(hash, m_bufferVersions[ubo.ID]);
+		}
+
+		// system values are hashed with the pass' viewport size, the global one is restored afterwards
+		SystemVariableManager& systemVM = SystemVariableManager::Instance();
+		glm::vec2 lastViewport = systemVM.GetViewportSize();
+		systemVM.SetViewportSize(rtSize.x, rtSize.y);
+		if (data->Variables.UsesSystemBlock()) {
+			SystemUniformBlock block;
+			systemVM.GetUniformBlock(block);
+			HashValue(hash, block);
+		}
+
+		for (const InputLayoutItem& layout : data->InputLayout) {
+			HashValue(hash, layout.Value);
+			HashBytes(hash, layout.Semantic.c_str(), layout.Semantic.size());
+		}
+
+		// variables and properties of each item
+		bool hasPlugin = false;
+		for (PipelineItem* child : data->Items) {
+			HashValue(hash, child);
+
+			if (child->Type == PipelineItem::ItemType::Geometry) {
+				pipe::GeometryItem* geoData = (pipe::GeometryItem*)child->Data;
+				HashValue(hash, geoData->Type);
+				HashValue(hash, geoData->Size);
+				HashValue(hash, geoData->Topology);
+				HashValue(hash, geoData->VAO);
+				HashValue(hash, geoData->Instanced);
+				HashValue(hash, geoData->InstanceCount);
+				if (geoData->InstanceBuffer != nullptr) {
+					GLuint instID = ((BufferObject*)geoData->InstanceBuffer)->ID;
+					HashValue(hash, instID);
+					HashValue(hash, m_bufferVersions[instID]);
+				}
+
+				m_updateItemValues(child, width, height);
+				data->Variables.Hash(child, hash);
+			}
+			else if (child->Type == PipelineItem::ItemType::Model) {
+				pipe::Model* objData = (pipe::Model*)child->Data;
+				HashValue(hash, objData->Data);
+				HashValue(hash, objData->OnlyGroup);
+				HashBytes(hash, objData->GroupName, strlen(objData->GroupName));
+				HashValue(hash, objData->Instanced);
+				HashValue(hash, objData->InstanceCount);
+				if (objData->InstanceBuffer != nullptr) {
+					GLuint instID = ((BufferObject*)objData->InstanceBuffer)->ID;
+					HashValue(hash, instID);
+					HashValue(hash, m_bufferVersions[instID]);
+				}
+
+				m_updateItemValues(child, width, height);
+				data->Variables.Hash(child, hash);
+			}
+			else if (child->Type == PipelineItem::ItemType::RenderState)
+				HashBytes(hash, child->Data, sizeof(pipe::RenderState));
+			else if (child->Type == PipelineItem::ItemType::PluginItem) {
+				hasPlugin = true; // we don't know what the plugin renders
+				break;
+			}
+		}
+
+		systemVM.SetViewportSize(lastViewport.x, lastViewport.y);
+
+		if (hasPlugin)
+			return 0;
+		return hash == 0 ? 1 : hash;
+	}
+	void RenderEngine::m_updateItemValues(PipelineItem* item, int width, int height)
+	{
+		SystemVariableManager& systemVM = SystemVariableManager::Instance();
+
+		if (item->Type == PipelineItem::ItemType::Geometry) {
+			pipe::GeometryItem* geoData = reinterpret_cast<pipe::GeometryItem*>(item->Data);
+
+			if (geoData->Type == pipe::GeometryItem::Rectangle) {
+				// TODO: don't multiply with m_renderer->GetLastRenderSize() but rather with actual RT size
+				glm::vec3 scaleRect(geoData->Scale.x * width, geoData->Scale.y * height, 1.0f);
+				glm::vec3 posRect((geoData->Position.x + 0.5f) * width, (geoData->Position.y + 0.5f) * height, -1000.0f);
+				systemVM.SetGeometryTransform(item, scaleRect, geoData->Rotation, posRect);
+			} else
+				systemVM.SetGeometryTransform(item, geoData->Scale, geoData->Rotation, geoData->Position);
+		} else if (item->Type == PipelineItem::ItemType::Model) {
+			pipe::Model* objData = reinterpret_cast<pipe::Model*>(item->Data);
+			systemVM.SetGeometryTransform(item, objData->Scale, objData->Rotation, objData->Position);
+		}
+
+		systemVM.SetPicked(std::count(m_pick.begin(), m_pick.end(), item));
+	}
+
+	bool RenderEngine::m_isPassScheduled(PipelineItem* item, int runEvery, float maxRate, int slices, int& slice)
+	{
+		slice = 0;
+		if (runEvery <= 1 && maxRate <= 0.0f && slices <= 1)
+			return true;
+
+		// the first execution happens immediately
+		auto sched = m_passSchedule.find(item);
+		if (sched == m_passSchedule.end()) {
+			PassSchedule& newSched = m_passSchedule[item];
+			newSched.Frames = 0;
+			newSched.Clock.Restart();
+			newSched.Slice = 0;
+			return true;
+		}
+
+		PassSchedule& cur = sched->second;
+		cur.Frames++;
+		if (cur.Frames < runEvery)
+			return false;
+		if (maxRate > 0.0f && cur.Clock.GetElapsedTime() < 1.0f / maxRate)
+			return false;
+
+		cur.Frames = 0;
+		cur.Clock.Restart();
+		cur.Slice = (cur.Slice + 1) % std::max(slices, 1);
+		slice = cur.Slice;
+
+		return true;
+	}
 }
\ No newline at end of file
@@ -4,9 +4,15 @@
 #include "ProjectParser.h"
 #include "MessageStack.h"
 #include "PluginAPI/PluginManager.h"
+#include "PipelineProfiler.h"
+#include "RenderGraph.h"
+#include "RenderTexturePool.h"
+#include "Hash.h"
+#include "SystemVariableManager.h"
 #include "../Engine/Timer.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 
 #include <glm/glm.hpp>
@@ -57,38 +63,28 @@ namespace ed
 		inline bool IsPaused() { return m_paused; }
 		void Pause(bool pause);
 
+		inline PipelineProfiler& GetProfiler() { return m_profiler; }
+		inline RenderGraph& GetGraph() { return m_graph; }
+
 	public:
 		struct ItemVariableValue
 		{
 			ItemVariableValue(ed::ShaderVariable* var) { 
 				Variable = var;
-				OldValue = var->Data;
 				NewValue = new ShaderVariable(var->GetType(), var->Name, var->System);
 				NewValue->Function = var->Function;
 				Item = nullptr;
 			}
 			PipelineItem* Item;
 			ed::ShaderVariable* Variable;
-			char* OldValue;
 			ed::ShaderVariable* NewValue;
 		};
 
+		// the values are also registered in the owner pass' ShaderVariableContainer which applies them while binding
 		inline std::vector<ItemVariableValue>& GetItemVariableValues() { return m_itemValues; }
-		inline void AddItemVariableValue(const ItemVariableValue& item) { m_itemValues.push_back(item); }
-		inline void RemoveItemVariableValue(PipelineItem* item, ShaderVariable* var) {
-			for (int i = 0; i < m_itemValues.size(); i++)
-				if (m_itemValues[i].Item == item && m_itemValues[i].Variable == var) {
-					m_itemValues.erase(m_itemValues.begin() + i);
-					return;
-				}
-		}
-		inline void RemoveItemVariableValues(PipelineItem* item) {
-			for (int i = 0; i < m_itemValues.size(); i++)
-				if (m_itemValues[i].Item == item) {
-					m_itemValues.erase(m_itemValues.begin() + i);
-					i--;
-				}
-		}
+		void AddItemVariableValue(const ItemVariableValue& item);
+		void RemoveItemVariableValue(PipelineItem* item, ShaderVariable* var);
+		void RemoveItemVariableValues(PipelineItem* item);
 
 	private:
 		PipelineManager* m_pipeline;
@@ -104,18 +100,18 @@ namespace ed
 		// paused time?
 		bool m_paused;
 
+		// per item CPU & GPU timings
+		PipelineProfiler m_profiler;
+		RenderGraph m_graph;
+		RenderTexturePool m_rtPool;
+
 		/* 'window' FBO */
 		glm::ivec2 m_lastSize;
 		GLuint m_rtColor, m_rtDepth, m_rtColorMS, m_rtDepthMS;
 		bool m_fbosNeedUpdate;
 
-		// check for the #include's & change the source code accordingly (includeStack == prevent recursion)
-		void m_includeCheck(std::string& src, std::vector<std::string> includeStack, int& lineBias);
-
-		// apply macros to GLSL source code
-		void m_applyMacros(std::string& source, pipe::ShaderPass* pass);
-		void m_applyMacros(std::string& source, pipe::ComputePass* pass);
-		void m_applyMacros(std::string& source, pipe::AudioPass* pass); // TODO: merge this function with the ones above
+		// check for the #include's & change the source code accordingly
+		void m_includeCheck(std::string& src, int& lineBias);
 		
 		// does a shader pass with GSUsed set also use this texture
 		bool m_isGSUsedSet(GLuint rt);
@@ -142,11 +138,35 @@ namespace ed
 
 		GLuint m_debugPixelShader, m_debugVertexPickShader, m_debugInstancePickShader;
 
-		void m_updatePassFBO(ed::pipe::ShaderPass* pass);
+		// SHADERed_System uniform block - only uploaded when the values change (new frame, different viewport size)
+		GLuint m_systemUBO;
+		SystemUniformBlock m_systemBlock;
+		void m_updateSystemUBO();
 
-		std::vector<ItemVariableValue> m_itemValues; // list of all values to apply once we start rendering 
+		void m_updatePassFBO(ed::pipe::ShaderPass* pass);
 
-		eng::Timer m_cacheTimer;
+		// skip the passes whose inputs haven't changed since the last render (or which are frozen)
+		struct PassCache { uint64_t Targets, Inputs; };
+		std::unordered_map<PipelineItem*, PassCache> m_passCache;
+		std::unordered_map<GLuint, unsigned int> m_textureVersions, m_bufferVersions; // increased each time a pass writes to the resource
+		bool m_isPassCached(int index, int width, int height);
+		uint64_t m_hashPassTargets(int index, int width, int height);
+		uint64_t m_hashPassInputs(int index, int width, int height); // 0 -> the pass can't be cached
+		void m_updateItemValues(PipelineItem* item, int width, int height); // geometry transform & picked
+
+		// execution rate of the passes (every N frames, N times per second, in slices)
+		struct PassSchedule { int Frames; eng::Timer Clock; int Slice; };
+		std::unordered_map<PipelineItem*, PassSchedule> m_passSchedule;
+		bool m_isPassScheduled(PipelineItem* item, int runEvery, float maxRate, int slices, int& slice); // slice -> which part of the pass to execute
+		std::unordered_set<PipelineItem*> m_unslicedPasses; // sliced compute passes that don't use PassSlice (already warned about)
+
+		std::vector<ItemVariableValue> m_itemValues; // list of all the per-item values
+		ShaderVariableContainer* m_getItemValueContainer(PipelineItem* item);
+
+		// apply the PipelineManager's events to the cache
+		bool m_cacheRebuild; // cache the whole pipeline on the next m_cache() call
 		void m_cache();
+		void m_cacheItem(PipelineItem* item);
+		void m_uncacheItem(PipelineItem* item, void* data);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "RenderGraph.h"
+#include "ObjectManager.h"
+#include "PipelineItem.h"
+#include <algorithm>
+
+namespace ed
+{
+	RenderGraph::RenderGraph()
+	{ }
+	void RenderGraph::Build(const std::vector<PipelineItem*>& items, ObjectManager* objects, GLuint window)
+	{
+		m_nodes.resize(items.size());
+
+		bool hasPluginItems = false;
+		for (int i = 0; i < items.size(); i++) {
+			PipelineItem* item = items[i];
+			Node& node = m_nodes[i];
+
+			node.Item = item;
+			node.InTextures.clear();
+			node.InBuffers.clear();
+			node.OutTextures.clear();
+			node.OutBuffers.clear();
+			node.Root = false;
+			node.Used = false;
+
+			if (item->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* data = (pipe::ShaderPass*)item->Data;
+				if (!data->Active)
+					continue;
+
+				for (int j = 0; j < MAX_RENDER_TEXTURES && data->RenderTextures[j] != 0; j++)
+					node.OutTextures.push_back(data->RenderTextures[j]);
+
+				const BindTable& binds = objects->GetBindTable(item);
+				for (const ResourceBind& srv : binds.Textures)
+					if (srv.Plugin == nullptr)
+						node.InTextures.push_back(srv.ID);
+				for (const ResourceBind& ubo : binds.Buffers)
+					if (ubo.Plugin == nullptr)
+						node.InBuffers.push_back(ubo.ID);
+
+				for (PipelineItem* child : data->Items) {
+					BufferObject* instBuffer = nullptr;
+					if (child->Type == PipelineItem::ItemType::Geometry)
+						instBuffer = (BufferObject*)((pipe::GeometryItem*)child->Data)->InstanceBuffer;
+					else if (child->Type == PipelineItem::ItemType::Model)
+						instBuffer = (BufferObject*)((pipe::Model*)child->Data)->InstanceBuffer;
+					else if (child->Type == PipelineItem::ItemType::PluginItem)
+						node.Root = true; // we don't know what the plugin does with the pass' output
+
+					if (instBuffer != nullptr)
+						node.InBuffers.push_back(instBuffer->ID);
+				}
+			}
+			else if (item->Type == PipelineItem::ItemType::ComputePass) {
+				const BindTable& binds = objects->GetBindTable(item);
+				for (const ResourceBind& srv : binds.Textures)
+					if (srv.Plugin == nullptr)
+						node.InTextures.push_back(srv.ID);
+
+				// images and storage buffers can be both read and written
+				for (const ResourceBind& uav : binds.Buffers) {
+					if (uav.Plugin != nullptr)
+						continue;
+
+					if (uav.Target == GL_TEXTURE_2D || uav.Target == GL_TEXTURE_3D) {
+						node.InTextures.push_back(uav.ID);
+						node.OutTextures.push_back(uav.ID);
+					} else {
+						node.InBuffers.push_back(uav.ID);
+						node.OutBuffers.push_back(uav.ID);
+					}
+				}
+			}
+			else if (item->Type == PipelineItem::ItemType::AudioPass) {
+				const BindTable& binds = objects->GetBindTable(item);
+				for (const ResourceBind& srv : binds.Textures)
+					if (srv.Plugin == nullptr)
+						node.InTextures.push_back(srv.ID);
+				for (const ResourceBind& ssbo : binds.Buffers)
+					if (ssbo.Plugin == nullptr)
+						node.InBuffers.push_back(ssbo.ID);
+
+				node.Root = true;
+			}
+			else if (item->Type == PipelineItem::ItemType::PluginItem) {
+				node.Root = true;
+				hasPluginItems = true;
+			}
+		}
+
+		// number of items that write to each resource
+		m_textureWriters.clear();
+		m_bufferWriters.clear();
+		for (const Node& node : m_nodes) {
+			for (GLuint tex : node.OutTextures)
+				m_textureWriters[tex]++;
+			for (GLuint buf : node.OutBuffers)
+				m_bufferWriters[buf]++;
+		}
+		for (Node& node : m_nodes) {
+			node.Exclusive = true;
+			for (GLuint tex : node.OutTextures)
+				node.Exclusive &= m_textureWriters[tex] == 1 && std::count(node.InTextures.begin(), node.InTextures.end(), tex) == 0;
+			for (GLuint buf : node.OutBuffers)
+				node.Exclusive &= m_bufferWriters[buf] == 1 && std::count(node.InBuffers.begin(), node.InBuffers.end(), buf) == 0;
+		}
+
+		// plugin items can read any resource through the plugin API
+		if (hasPluginItems) {
+			for (Node& node : m_nodes)
+				node.Used = true;
+			return;
+		}
+
+		m_usedTextures.clear();
+		m_usedBuffers.clear();
+		m_usedTextures.insert(window);
+		m_usedTextures.insert(m_watchedTextures.begin(), m_watchedTextures.end());
+		m_usedBuffers.insert(m_watchedBuffers.begin(), m_watchedBuffers.end());
+
+		// the order of the passes doesn't matter - a pass can read what a later pass wrote in the last frame
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (Node& node : m_nodes) {
+				if (!node.Used)
+					node.Used = node.Root || m_isUsed(node);
+				if (node.Used)
+					changed |= m_use(node);
+			}
+		}
+	}
+	void RenderGraph::SetWatched(const std::vector<GLuint>& textures, const std::vector<GLuint>& buffers)
+	{
+		m_watchedTextures = textures;
+		m_watchedBuffers = buffers;
+	}
+	bool RenderGraph::IsUsed(PipelineItem* item)
+	{
+		const Node* node = m_getNode(item);
+		return node == nullptr || node->Used;
+	}
+	std::vector<PipelineItem*> RenderGraph::GetInputs(PipelineItem* item)
+	{
+		std::vector<PipelineItem*> ret;
+
+		const Node* node = m_getNode(item);
+		if (node == nullptr)
+			return ret;
+
+		for (const Node& other : m_nodes) {
+			if (&other == node)
+				continue;
+
+			bool reads = false;
+			for (GLuint tex : other.OutTextures)
+				reads |= std::count(node->InTextures.begin(), node->InTextures.end(), tex) > 0;
+			for (GLuint buf : other.OutBuffers)
+				reads |= std::count(node->InBuffers.begin(), node->InBuffers.end(), buf) > 0;
+
+			if (reads)
+				ret.push_back(other.Item);
+		}
+
+		return ret;
+	}
+	std::vector<PipelineItem*> RenderGraph::GetOutputs(PipelineItem* item)
+	{
+		std::vector<PipelineItem*> ret;
+
+		const Node* node = m_getNode(item);
+		if (node == nullptr)
+			return ret;
+
+		for (const Node& other : m_nodes) {
+			if (&other == node)
+				continue;
+
+			bool reads = false;
+			for (GLuint tex : node->OutTextures)
+				reads |= std::count(other.InTextures.begin(), other.InTextures.end(), tex) > 0;
+			for (GLuint buf : node->OutBuffers)
+				reads |= std::count(other.InBuffers.begin(), other.InBuffers.end(), buf) > 0;
+
+			if (reads)
+				ret.push_back(other.Item);
+		}
+
+		return ret;
+	}
+	const RenderGraph::Node* RenderGraph::m_getNode(PipelineItem* item)
+	{
+		for (const Node& node : m_nodes)
+			if (node.Item == item)
+				return &node;
+		return nullptr;
+	}
+	bool RenderGraph::m_isUsed(const Node& node)
+	{
+		for (GLuint tex : node.OutTextures)
+			if (m_usedTextures.count(tex))
+				return true;
+		for (GLuint buf : node.OutBuffers)
+			if (m_usedBuffers.count(buf))
+				return true;
+		return false;
+	}
+	bool RenderGraph::m_use(const Node& node)
+	{
+		bool added = false;
+		for (GLuint tex : node.InTextures)
+			added |= m_usedTextures.insert(tex).second;
+		for (GLuint buf : node.InBuffers)
+			added |= m_usedBuffers.insert(buf).second;
+		return added;
+	}
+}
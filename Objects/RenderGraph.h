@@ -0,0 +1,63 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#if defined(__APPLE__)
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ed
+{
+	struct PipelineItem;
+	class ObjectManager;
+
+	// which resources each top level pipeline item reads and writes - a pass is used if it writes
+	// to the window, plays audio or writes a resource that a used pass (or an open preview) reads
+	class RenderGraph
+	{
+	public:
+		struct Node
+		{
+			PipelineItem* Item;
+			std::vector<GLuint> InTextures, InBuffers;		// bound textures, UBOs, instance buffers, ...
+			std::vector<GLuint> OutTextures, OutBuffers;	// render textures, images & SSBOs (compute)
+			bool Root;		// always used (audio pass, plugin item)
+			bool Used;
+			bool Exclusive;	// nothing else writes to this item's outputs and the item doesn't read them
+		};
+
+		RenderGraph();
+
+		// items must be in the render order - Node i belongs to items[i]
+		void Build(const std::vector<PipelineItem*>& items, ObjectManager* objects, GLuint window);
+
+		// resources that are shown outside of the pipeline (ObjectPreviewUI)
+		void SetWatched(const std::vector<GLuint>& textures, const std::vector<GLuint>& buffers);
+
+		inline bool IsUsed(int index) { return m_nodes[index].Used; }
+		bool IsUsed(PipelineItem* item);
+		inline bool IsExclusive(int index) { return m_nodes[index].Exclusive; }
+
+		inline const std::vector<Node>& GetNodes() { return m_nodes; }
+		std::vector<PipelineItem*> GetInputs(PipelineItem* item);	// items that write what this item reads
+		std::vector<PipelineItem*> GetOutputs(PipelineItem* item);	// items that read what this item writes
+
+	private:
+		const Node* m_getNode(PipelineItem* item);
+		bool m_isUsed(const Node& node);
+		bool m_use(const Node& node);
+
+		std::vector<Node> m_nodes; // rebuilt every frame, the lists inside keep their memory
+
+		std::vector<GLuint> m_watchedTextures, m_watchedBuffers;
+		std::unordered_set<GLuint> m_usedTextures, m_usedBuffers;
+		std::unordered_map<GLuint, int> m_textureWriters, m_bufferWriters;
+	};
+}
@@ -0,0 +1,167 @@
+#include "RenderTexturePool.h"
+#include "ObjectManager.h"
+#include "PipelineItem.h"
+#include "Settings.h"
+#include "Logger.h"
+#include <algorithm>
+#include <limits>
+
+namespace ed
+{
+	RenderTexturePool::RenderTexturePool()
+	{
+		m_samples = 0;
+	}
+	RenderTexturePool::~RenderTexturePool()
+	{
+		Clear();
+	}
+	bool RenderTexturePool::Build(const std::vector<PipelineItem*>& items, ObjectManager* objects, int width, int height)
+	{
+		// passes that render to each transient render texture
+		m_uses.clear();
+		for (int i = 0; i < items.size(); i++) {
+			if (items[i]->Type != PipelineItem::ItemType::ShaderPass)
+				continue;
+
+			pipe::ShaderPass* data = (pipe::ShaderPass*)items[i]->Data;
+			if (!data->Active)
+				continue;
+
+			for (int j = 0; j < data->RTCount; j++) {
+				GLuint rt = data->RenderTextures[j];
+				RenderTextureObject* rtObj = objects->GetRenderTexture(rt);
+				if (rtObj == nullptr || !rtObj->Transient)
+					continue;
+
+				auto use = std::find_if(m_uses.begin(), m_uses.end(), [&](const Use& u) { return u.RT == rt; });
+				if (use == m_uses.end()) {
+					Use newUse;
+					newUse.RT = rt;
+					newUse.Size = rtObj->CalculateSize(width, height);
+					newUse.Format = rtObj->Format;
+					newUse.First = newUse.Last = i;
+					newUse.Persistent = !rtObj->Clear;
+					m_uses.push_back(newUse);
+				} else
+					use->Last = i;
+			}
+		}
+
+		// give each render texture the first buffers that aren't used anymore when it's rendered to for the first time
+		std::stable_sort(m_uses.begin(), m_uses.end(), [](const Use& a, const Use& b) { return a.First < b.First; });
+		m_newSlots.clear();
+		m_newAssigned.clear();
+		for (const Use& use : m_uses) {
+			int slotIndex = -1;
+			for (int i = 0; i < m_newSlots.size() && !use.Persistent; i++) {
+				const Slot& slot = m_newSlots[i];
+				if (slot.Size == use.Size && slot.Format == use.Format && slot.LastUse < use.First) {
+					slotIndex = i;
+					break;
+				}
+			}
+
+			if (slotIndex == -1) {
+				Slot slot;
+				slot.Size = use.Size;
+				slot.Format = use.Format;
+				slot.DepthStencil = slot.ColorMS = slot.DepthStencilMS = 0;
+				slotIndex = m_newSlots.size();
+				m_newSlots.push_back(slot);
+			}
+
+			m_newSlots[slotIndex].LastUse = use.Persistent ? std::numeric_limits<int>::max() : use.Last;
+			m_newAssigned[use.RT] = slotIndex;
+		}
+
+		// nothing changed -> keep the buffers
+		int samples = Settings::Instance().Preview.MSAA;
+		bool changed = samples != m_samples || m_newSlots.size() != m_slots.size() || m_newAssigned != m_assigned;
+		for (int i = 0; i < m_newSlots.size() && !changed; i++)
+			changed = m_newSlots[i].Size != m_slots[i].Size || m_newSlots[i].Format != m_slots[i].Format;
+		if (!changed)
+			return false;
+
+		Clear();
+		m_samples = samples;
+		m_slots.swap(m_newSlots);
+		m_assigned.swap(m_newAssigned);
+		for (Slot& slot : m_slots)
+			m_allocate(slot);
+
+		if (m_uses.size() > 0) {
+			size_t shared = 0, separate = 0;
+			for (const Slot& slot : m_slots)
+				shared += m_getSize(slot);
+			for (const auto& assigned : m_assigned)
+				separate += m_getSize(m_slots[assigned.second]);
+
+			Logger::Get().Log("Transient render textures: " + std::to_string(m_uses.size()) + " render textures share " + std::to_string(m_slots.size()) + " sets of depth & multisampled buffers (" +
+				std::to_string(shared / 1024) + "KB instead of " + std::to_string(separate / 1024) + "KB, color textures aren't shared)");
+		}
+
+		return true;
+	}
+	void RenderTexturePool::Clear()
+	{
+		for (Slot& slot : m_slots)
+			m_free(slot);
+		m_slots.clear();
+		m_assigned.clear();
+		m_samples = 0;
+	}
+	void RenderTexturePool::m_allocate(Slot& slot)
+	{
+		// depth texture
+		glGenTextures(1, &slot.DepthStencil);
+		glBindTexture(GL_TEXTURE_2D, slot.DepthStencil);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, slot.Size.x, slot.Size.y, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// color texture ms
+		glGenTextures(1, &slot.ColorMS);
+		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, slot.ColorMS);
+		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_samples, slot.Format, slot.Size.x, slot.Size.y, true);
+
+		// depth texture ms
+		glGenTextures(1, &slot.DepthStencilMS);
+		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, slot.DepthStencilMS);
+		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_samples, GL_DEPTH24_STENCIL8, slot.Size.x, slot.Size.y, true);
+		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+	}
+	size_t RenderTexturePool::m_getSize(const Slot& slot)
+	{
+		const GLuint textures[] = { slot.DepthStencil, slot.ColorMS, slot.DepthStencilMS };
+		const GLenum targets[] = { GL_TEXTURE_2D, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_2D_MULTISAMPLE };
+		const GLenum bitQueries[] = { GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE, GL_TEXTURE_DEPTH_SIZE, GL_TEXTURE_STENCIL_SIZE };
+
+		size_t ret = 0;
+		for (int i = 0; i < 3; i++) {
+			glBindTexture(targets[i], textures[i]);
+
+			GLint bits = 0, samples = 1;
+			for (GLenum query : bitQueries) {
+				GLint queryBits = 0;
+				glGetTexLevelParameteriv(targets[i], 0, query, &queryBits);
+				bits += queryBits;
+			}
+			if (targets[i] == GL_TEXTURE_2D_MULTISAMPLE)
+				glGetTexLevelParameteriv(targets[i], 0, GL_TEXTURE_SAMPLES, &samples);
+
+			ret += (size_t)slot.Size.x * slot.Size.y * std::max(samples, 1) * bits / 8;
+			glBindTexture(targets[i], 0);
+		}
+
+		return ret;
+	}
+	void RenderTexturePool::m_free(Slot& slot)
+	{
+		glDeleteTextures(1, &slot.DepthStencil);
+		glDeleteTextures(1, &slot.ColorMS);
+		glDeleteTextures(1, &slot.DepthStencilMS);
+		slot.DepthStencil = slot.ColorMS = slot.DepthStencilMS = 0;
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/glew.h>
+#if defined(__APPLE__)
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace ed
+{
+	struct PipelineItem;
+	class ObjectManager;
+
+	// depth-stencil & multisampled buffers of the transient render textures - they are only used while a pass
+	// renders to the render texture, so render textures that are rendered to in different parts of the frame
+	// (and have the same size & format) can share them
+	// the color textures are NOT shared: their IDs are bound as inputs by the later passes and shown in the UI, so
+	// every render texture keeps its own. With MSAA off a RGBA8 render texture owns 16 bytes/pixel (color, depth,
+	// 1x MS color & MS depth) and 12 of them can be shared, with 4x MSAA it's 36 of 40 - N render textures that
+	// share one set of buffers need 4N+12 (4N+36) instead of 16N (40N) bytes/pixel, not 1/N of the memory.
+	// Build() logs the sizes reported by the driver.
+	class RenderTexturePool
+	{
+	public:
+		RenderTexturePool();
+		~RenderTexturePool();
+
+		// items must be in the render order - returns true if the attachments have changed (FBOs have to be updated)
+		bool Build(const std::vector<PipelineItem*>& items, ObjectManager* objects, int width, int height);
+		void Clear();
+
+		inline bool IsPooled(GLuint rt) { return m_assigned.count(rt) > 0; }
+		inline GLuint GetDepthStencil(GLuint rt) { return m_slots[m_assigned[rt]].DepthStencil; }
+		inline GLuint GetColorMS(GLuint rt) { return m_slots[m_assigned[rt]].ColorMS; }
+		inline GLuint GetDepthStencilMS(GLuint rt) { return m_slots[m_assigned[rt]].DepthStencilMS; }
+
+		inline int GetSlotCount() { return m_slots.size(); }
+
+	private:
+		struct Use
+		{
+			GLuint RT;
+			glm::ivec2 Size;
+			GLuint Format;
+			int First, Last; // index of the first and the last pass that renders to the RT
+			bool Persistent; // not cleared -> keeps its own buffers
+		};
+		struct Slot
+		{
+			glm::ivec2 Size;
+			GLuint Format;
+			int LastUse;
+			GLuint DepthStencil, ColorMS, DepthStencilMS;
+		};
+
+		void m_allocate(Slot& slot);
+		void m_free(Slot& slot);
+		size_t m_getSize(const Slot& slot); // in bytes, as reported by the driver
+
+		std::vector<Use> m_uses;
+		std::vector<Slot> m_slots;
+		std::unordered_map<GLuint, int> m_assigned; // render texture -> slot
+
+		std::vector<Slot> m_newSlots;
+		std::unordered_map<GLuint, int> m_newAssigned;
+		int m_samples;
+	};
+}
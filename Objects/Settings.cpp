@@ -65,6 +65,9 @@ namespace ed
 		Preview.FPSLimit = -1;
 		Preview.ApplyFPSLimitToApp = false;
 		Preview.LostFocusLimitFPS = false;
+		Preview.SkipUnusedPasses = true;
+		Preview.CachePasses = true;
+		Preview.GLCallCounters = false;
 		Preview.MSAA = 1;
 	}
 	void Settings::Load()
@@ -132,6 +135,9 @@ namespace ed
 		Preview.FPSLimit = ini.GetInteger("preview", "fpslimit", -1);
 		Preview.ApplyFPSLimitToApp = ini.GetBoolean("preview", "fpslimitwholeapp", false);
 		Preview.LostFocusLimitFPS = ini.GetBoolean("preview", "fpslimitlostfocus", false);
+		Preview.SkipUnusedPasses = ini.GetBoolean("preview", "skipunusedpasses", true);
+		Preview.CachePasses = ini.GetBoolean("preview", "cachepasses", true);
+		Preview.GLCallCounters = ini.GetBoolean("preview", "glcallcounters", false);
 		Preview.MSAA = ini.GetInteger("preview", "msaa", 1);
 
 		m_parseExt(ini.Get("plugins", "notloaded", ""), Plugins.NotLoaded);
@@ -203,6 +209,9 @@ namespace ed
 		ini << "fpslimit=" << Preview.FPSLimit << std::endl;
 		ini << "fpslimitwholeapp=" << Preview.ApplyFPSLimitToApp << std::endl;
 		ini << "fpslimitlostfocus=" << Preview.LostFocusLimitFPS << std::endl;
+		ini << "skipunusedpasses=" << Preview.SkipUnusedPasses << std::endl;
+		ini << "cachepasses=" << Preview.CachePasses << std::endl;
+		ini << "glcallcounters=" << Preview.GLCallCounters << std::endl;
 		ini << "msaa=" << Preview.MSAA << std::endl;
 
 		ini << "[editor]" << std::endl;
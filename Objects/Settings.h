@@ -77,6 +77,9 @@ namespace ed
 			int FPSLimit;
 			bool ApplyFPSLimitToApp; // apply FPSLimit to whole app, not only preview
 			bool LostFocusLimitFPS; // limit to 30FPS when app loses focus
+			bool SkipUnusedPasses; // don't render the passes whose output isn't visible anywhere
+			bool CachePasses; // reuse the output of the passes whose inputs didn't change
+			bool GLCallCounters; // count the GL calls made in each frame & show them in the status bar
 			int MSAA; // 1 (off), 2, 4, 8
 		} Preview;
 
@@ -0,0 +1,75 @@
+#include "ShaderPreprocessor.h"
+#include <algorithm>
+
+namespace ed
+{
+	void ShaderPreprocessor::ResolveIncludes(std::string& src, const std::vector<std::string>& includePaths, const FileLoader& loadFile, MessageStack* msgs, const std::string& item, int& lineBias, std::vector<std::string> includeStack)
+	{
+		size_t incLoc = src.find("#include");
+
+		std::vector<std::string> paths = includePaths;
+		paths.push_back(".");
+
+		while (incLoc != std::string::npos) {
+			bool isAfterNewline = true;
+			if (incLoc != 0)
+				if (src[incLoc - 1] != '\n')
+					isAfterNewline = false;
+
+			if (!isAfterNewline) {
+				incLoc = src.find("#include", incLoc + 1);
+				continue;
+			}
+
+			size_t quotePos = src.find_first_of("\"<", incLoc);
+			size_t quoteEnd = src.find_first_of("\">", quotePos + 1);
+			std::string fileName = src.substr(quotePos + 1, quoteEnd - quotePos - 1);
+
+			for (int i = 0; i < paths.size(); i++) {
+				std::string ipath = paths[i];
+				char last = ipath[ipath.size() - 1];
+				if (last != '\\' && last != '/')
+					ipath += "/";
+
+				ipath += fileName;
+
+				src.erase(incLoc, src.find_first_of('\n', incLoc) - incLoc);
+
+				bool isRecursive = std::count(includeStack.begin(), includeStack.end(), ipath) > 0;
+				if (isRecursive)
+					msgs->Add(MessageStack::Type::Error, item, "Recursive #include detected");
+
+				std::string incFileSrc;
+				if (!isRecursive && loadFile(ipath, incFileSrc)) {
+					includeStack.push_back(ipath);
+
+					lineBias = std::count(incFileSrc.begin(), incFileSrc.end(), '\n');
+
+					ResolveIncludes(incFileSrc, includePaths, loadFile, msgs, item, lineBias, includeStack);
+
+					src.insert(incLoc, incFileSrc);
+
+					break;
+				}
+			}
+
+			incLoc = src.find("#include", incLoc + 1);
+		}
+	}
+	void ShaderPreprocessor::ApplyMacros(std::string& src, const std::vector<ShaderMacro>& macros)
+	{
+		size_t verLoc = src.find_first_of("#version");
+		size_t lineLoc = src.find_first_of('\n', verLoc + 1) + 1;
+		std::string strMacro = "";
+
+		for (auto& macro : macros) {
+			if (!macro.Active)
+				continue;
+
+			strMacro += "#define " + std::string(macro.Name) + " " + std::string(macro.Value) + "\n";
+		}
+
+		if (strMacro.size() > 0)
+			src.insert(lineLoc, strMacro);
+	}
+}
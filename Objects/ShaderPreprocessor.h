@@ -0,0 +1,24 @@
+#pragma once
+#include "MessageStack.h"
+#include "ShaderMacro.h"
+
+#include <functional>
+#include <vector>
+#include <string>
+
+namespace ed
+{
+	// GLSL preprocessing that SHADERed does before the driver sees the source - shared by the RenderEngine & the BatchCompiler
+	class ShaderPreprocessor
+	{
+	public:
+		// loads an include file (path is relative to the project directory), returns false if the file doesn't exist
+		typedef std::function<bool(const std::string& path, std::string& content)> FileLoader;
+
+		// check for the #include's & change the source code accordingly (includeStack == prevent recursion)
+		static void ResolveIncludes(std::string& src, const std::vector<std::string>& includePaths, const FileLoader& loadFile, MessageStack* msgs, const std::string& item, int& lineBias, std::vector<std::string> includeStack = std::vector<std::string>());
+
+		// insert the active macros after the #version line
+		static void ApplyMacros(std::string& src, const std::vector<ShaderMacro>& macros);
+	};
+}
@@ -8,6 +8,7 @@
 #include "Settings.h"
 #include "HLSLFileIncluder.h"
 #include "ShaderTranscompiler.h"
+#include "SystemVariableManager.h"
 #include <glslang/glslang/Public/ShaderLang.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
 #include <glslang/StandAlone/DirStackFileIncluder.h>
@@ -149,6 +150,15 @@ namespace ed
 		return ShaderTranscompiler::TranscompileSource(inLang, filename, inputHLSL, sType, entry, macros, gsUsed, msgs, project);
 	}
 	std::string ShaderTranscompiler::TranscompileSource(ShaderLanguage inLang, const std::string &filename, const std::string &inputHLSL, int sType, const std::string &entry, std::vector<ShaderMacro> &macros, bool gsUsed, MessageStack *msgs, ProjectParser* project)
+	{
+		std::vector<std::string> includeDirs;
+		if (project != nullptr)
+			for (auto& str : Settings::Instance().Project.IncludePaths)
+				includeDirs.push_back(project->GetProjectPath(str));
+
+		return ShaderTranscompiler::TranscompileSource(inLang, filename, inputHLSL, sType, entry, macros, gsUsed, msgs, includeDirs);
+	}
+	std::string ShaderTranscompiler::TranscompileSource(ShaderLanguage inLang, const std::string &filename, const std::string &inputHLSL, int sType, const std::string &entry, std::vector<ShaderMacro> &macros, bool gsUsed, MessageStack *msgs, const std::vector<std::string>& includeDirs)
 	{
 		const char* inputStr = inputHLSL.c_str();
 
@@ -195,9 +205,8 @@ namespace ed
 		// includer
 		ed::HLSLFileIncluder includer;
 		includer.pushExternalLocalDirectory(filename.substr(0, filename.find_last_of("/\\")));
-		if (project != nullptr)
-			for (auto& str : Settings::Instance().Project.IncludePaths)
-				includer.pushExternalLocalDirectory(project->GetProjectPath(str));
+		for (auto& dir : includeDirs)
+			includer.pushExternalLocalDirectory(dir);
 
 		std::string processedShader;
 
@@ -310,13 +319,25 @@ namespace ed
 			std::stringstream ss(source);
 			std::string line;
 			source = "";
-			bool inUBO = false;
+			bool inUBO = false, inSystemUBO = false;
 			std::vector<std::string> uboNames;
 			while (std::getline(ss, line)) {
 
+				// keep the SHADERed_System block, but with the same matrix layout as the uniforms below
+				if (line.find("uniform " SYSTEM_UBO_NAME) != std::string::npos)
+					inSystemUBO = true;
+				else if (inSystemUBO) {
+					if (line[0] == '}')
+						inSystemUBO = false;
+					else {
+						size_t playout = line.find("layout(row_major) ");
+						if (playout != std::string::npos)
+							line.erase(playout, 18);
+					}
+				}
 				// i know, ewww, but idk if there's a function to do this (this = converting UBO
 				// to separate uniforms)...
-				if (line.find("layout(binding") != std::string::npos &&
+				else if (line.find("layout(binding") != std::string::npos &&
 					line.find("uniform") != std::string::npos &&
 					line.find("sampler") == std::string::npos &&
 					line.find("image") == std::string::npos &&
@@ -365,6 +386,7 @@ namespace ed
 				// to separate uniforms)...
 				if (line.find("layout(binding") != std::string::npos &&
 					line.find("uniform") != std::string::npos &&
+					line.find("uniform " SYSTEM_UBO_NAME) == std::string::npos &&
 					line.find("sampler") == std::string::npos &&
 					line.find("image") == std::string::npos &&
 					line.find(" buffer ") == std::string::npos)
@@ -13,6 +13,7 @@ namespace ed
 		/* TODO: enum for shaderType = { 0 -> vertex, 1 -> pixel, 2 -> geometry } */
 		static std::string Transcompile(ShaderLanguage inLang, const std::string &filename, int shaderType, const std::string &entry, std::vector<ShaderMacro> &macros, bool gsUsed, MessageStack *msgs, ProjectParser* project);
 		static std::string TranscompileSource(ShaderLanguage inLang, const std::string &filename, const std::string &source, int shaderType, const std::string &entry, std::vector<ShaderMacro> &macros, bool gsUsed, MessageStack *msgs, ProjectParser* project);
+		static std::string TranscompileSource(ShaderLanguage inLang, const std::string &filename, const std::string &source, int shaderType, const std::string &entry, std::vector<ShaderMacro> &macros, bool gsUsed, MessageStack *msgs, const std::vector<std::string>& includeDirs); // doesn't access any global state so it can be called from multiple threads
 		static ShaderLanguage GetShaderTypeFromExtension(const std::string& file);
 	};
 }
\ No newline at end of file
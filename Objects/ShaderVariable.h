@@ -41,6 +41,7 @@ namespace ed
 		Mouse,				// vec4 - (x,y,left,right) updated every frame
 		MouseButton,		// vec4 - (x,y,left,right) updated only when mouse button pressed
 		PluginVariable,		// a value that is updated by some plugin
+		PassSlice,			// ivec4 - (index, count) of the time slice of the pass that is executed in this frame, compute passes: (.., .., first work group along X, work groups along X)
 		Count
 	};
 
@@ -105,7 +106,7 @@ namespace ed
 			m_type(type), System(systemVar)
 		{
 			Arguments = nullptr;
-			Data = (char*)calloc(GetSize(type), 1);
+			Data = (char*)calloc(GetSize(ValueType::Float4x4), 1); // big enough for any type
 			memset(Name, 0, VARIABLE_NAME_LENGTH);
 			memcpy(Name, name, strlen(name));
 			Function = FunctionShaderVariable::None;
@@ -137,12 +138,13 @@ namespace ed
 			return 0;
 		}
 		
-		char Name[VARIABLE_NAME_LENGTH];	// name that a uniform variable has
+		// fields used while binding come first so that they share a cache line
 		SystemShaderVariable System;		// do we provide the value or does our system provide the value?
 		FunctionShaderVariable Function;	// do we input value or does system calculate it for us?
-		char* Data;			// allocated with malloc()
-		char* Arguments;	// space to store arguments for function - allocated if not null!!!
+		char* Data;			// allocated with malloc() or owned by the ShaderVariableContainer's value arena
 		char Flags;
+		char* Arguments;	// space to store arguments for function - allocated if not null!!!
+		char Name[VARIABLE_NAME_LENGTH];	// name that a uniform variable has
 		PluginSystemVariableData PluginSystemVarData;
 		PluginFunctionData PluginFuncData;
 
@@ -169,10 +171,7 @@ namespace ed
 				Arguments = nullptr;
 			}
 
-			m_type = newType;
-			char* tempData = (char*)realloc(Data, ShaderVariable::GetSize(m_type));
-			if (tempData != nullptr)
-				Data = tempData;
+			m_type = newType; // Data can already hold any type
 		}
 		inline ValueType GetType() { return m_type; }
 		inline int GetColumnCount()
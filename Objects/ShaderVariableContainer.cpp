@@ -1,40 +1,159 @@
 #include "ShaderVariableContainer.h"
 #include "FunctionVariableManager.h"
 #include "SystemVariableManager.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
-#include <regex>
+#include <sstream>
+
+#include "../Engine/GLCallCounterHooks.h"
 
 namespace ed
 {
-	ShaderVariableContainer::ShaderVariableContainer() { }
+	static bool isSamplerType(GLenum type)
+	{
+		switch (type) {
+		case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+		case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_CUBE_SHADOW:
+		case GL_SAMPLER_1D_ARRAY: case GL_SAMPLER_2D_ARRAY: case GL_SAMPLER_1D_ARRAY_SHADOW: case GL_SAMPLER_2D_ARRAY_SHADOW:
+		case GL_SAMPLER_2D_MULTISAMPLE: case GL_SAMPLER_2D_MULTISAMPLE_ARRAY: case GL_SAMPLER_BUFFER: case GL_SAMPLER_2D_RECT:
+		case GL_INT_SAMPLER_1D: case GL_INT_SAMPLER_2D: case GL_INT_SAMPLER_3D: case GL_INT_SAMPLER_CUBE:
+		case GL_INT_SAMPLER_1D_ARRAY: case GL_INT_SAMPLER_2D_ARRAY: case GL_INT_SAMPLER_2D_MULTISAMPLE:
+		case GL_UNSIGNED_INT_SAMPLER_1D: case GL_UNSIGNED_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_3D: case GL_UNSIGNED_INT_SAMPLER_CUBE:
+		case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+			return true;
+		}
+		return false;
+	}
+
+	ShaderVariableContainer::ShaderVariableContainer()
+	{
+		m_slotsDirty = true;
+		m_usesSystemBlock = false;
+	}
 	ShaderVariableContainer::~ShaderVariableContainer()
 	{
+		// values are freed together with m_values
 		for (int i = 0; i < m_vars.size(); i++) {
-			free(m_vars[i]->Data);
 			if (m_vars[i]->Arguments != nullptr)
 				free(m_vars[i]->Arguments);
 			m_vars[i]->Arguments = nullptr;
 			delete m_vars[i];
 		}
+		FunctionVariableManager::Invalidate();
+	}
+	void ShaderVariableContainer::Add(ShaderVariable* var)
+	{
+		char* value = m_allocValue();
+		memcpy(value, var->Data, ShaderVariable::GetSize(var->GetType()));
+		free(var->Data);
+		var->Data = value;
+
+		m_vars.push_back(var);
+		m_slotsDirty = true;
+		FunctionVariableManager::Invalidate();
 	}
 	void ShaderVariableContainer::AddCopy(ShaderVariable var)
 	{
-		ShaderVariable* n = new ShaderVariable(var);
-		m_vars.push_back(n);
+		Add(new ShaderVariable(var));
 	}
 	void ShaderVariableContainer::Remove(const char* name)
 	{
 		for (int i = 0; i < m_vars.size(); i++)
 			if (strcmp(m_vars[i]->Name, name) == 0) {
-				free(m_vars[i]->Data);
+				RemoveItemValue(nullptr, m_vars[i]);
+
+				// the value's slot is dropped the next time the arena gets packed
 				if (m_vars[i]->Arguments != nullptr)
 					free(m_vars[i]->Arguments);
 				m_vars[i]->Arguments = nullptr;
 				delete m_vars[i];
 				m_vars.erase(m_vars.begin() + i);
+				m_slotsDirty = true;
+				FunctionVariableManager::Invalidate();
 				break;
 			}
 	}
+	void ShaderVariableContainer::SetItemValue(void* item, ShaderVariable* var, ShaderVariable* value)
+	{
+		if (item == nullptr)
+			return;
+
+		for (ItemValue& val : m_itemValues)
+			if (val.Item == item && val.Variable == var) {
+				val.Value = value;
+				return;
+			}
+
+		ItemValue val;
+		val.Item = item;
+		val.Variable = var;
+		val.Value = value;
+		val.Slot = -1;
+		m_itemValues.push_back(val);
+		m_slotsDirty = true;
+	}
+	void ShaderVariableContainer::RemoveItemValue(void* item, ShaderVariable* var)
+	{
+		// item == nullptr -> remove the variable's values for all items
+		for (int i = 0; i < m_itemValues.size(); i++)
+			if ((item == nullptr || m_itemValues[i].Item == item) && m_itemValues[i].Variable == var) {
+				m_itemValues.erase(m_itemValues.begin() + i);
+				i--;
+			}
+		m_slotsDirty = true;
+	}
+	void ShaderVariableContainer::RemoveItemValues(void* item)
+	{
+		for (int i = 0; i < m_itemValues.size(); i++)
+			if (m_itemValues[i].Item == item) {
+				m_itemValues.erase(m_itemValues.begin() + i);
+				i--;
+			}
+		m_slotsDirty = true;
+	}
+	char* ShaderVariableContainer::GetValue(ShaderVariable* var, void* item)
+	{
+		// system & function values are computed, not overriden
+		if (var->System == SystemShaderVariable::None && var->Function == FunctionShaderVariable::None)
+			for (const ItemValue& val : m_itemValues)
+				if (val.Item == item && val.Variable == var)
+					return val.Value->Data;
+
+		return var->Data;
+	}
+	char* ShaderVariableContainer::m_allocValue()
+	{
+		if (m_values.size() == m_values.capacity()) {
+			std::vector<ValueSlot> values;
+			values.reserve(std::max<size_t>(16, m_values.size() * 2));
+			values.assign(m_values.begin(), m_values.end());
+
+			for (ShaderVariable* var : m_vars)
+				var->Data = values[(ValueSlot*)var->Data - m_values.data()].Data;
+
+			m_values.swap(values);
+		}
+
+		m_values.emplace_back();
+		return m_values.back().Data;
+	}
+	void ShaderVariableContainer::m_packValues()
+	{
+		bool packed = m_values.size() == m_vars.size();
+		for (int i = 0; i < m_vars.size() && packed; i++)
+			packed = m_vars[i]->Data == m_values[i].Data;
+		if (packed)
+			return;
+
+		std::vector<ValueSlot> values(m_vars.size());
+		for (int i = 0; i < m_vars.size(); i++)
+			memcpy(values[i].Data, m_vars[i]->Data, sizeof(ValueSlot));
+
+		m_values.swap(values);
+		for (int i = 0; i < m_vars.size(); i++)
+			m_vars[i]->Data = m_values[i].Data;
+	}
 	void ShaderVariableContainer::UpdateUniformInfo(GLuint pass)
 	{
 		GLint count;
@@ -42,7 +161,22 @@ namespace ed
 		const GLsizei bufSize = 64; // maximum name length
 		GLchar name[bufSize]; // variable name in GLSL
 		GLsizei length; // name length
-		GLuint samplerLoc = 0;
+		GLuint samplerLoc = m_samplers.size(); // samplers that aren't in the pixel shader get the units after the ones that are
+
+		// SHADERed_System block is filled by the RenderEngine
+		GLuint systemBlock = glGetUniformBlockIndex(pass, SYSTEM_UBO_NAME);
+		m_usesSystemBlock = systemBlock != GL_INVALID_INDEX;
+		if (m_usesSystemBlock)
+			glUniformBlockBinding(pass, systemBlock, SYSTEM_UBO_BINDING);
+
+		m_uLocs.clear();
+		m_uniforms.clear();
+		m_slotsDirty = true;
+
+		// glUniform*() only works on the bound program
+		GLint lastProgram = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &lastProgram);
+		glUseProgram(pass);
 
 		glGetProgramiv(pass, GL_ACTIVE_UNIFORMS, &count);
 		for (GLuint i = 0; i < count; i++)
@@ -52,109 +186,225 @@ namespace ed
 
 			glGetActiveUniform(pass, (GLuint)i, bufSize, &length, &size, &type, name);
 
-			if (type == GL_SAMPLER_2D)
-				glUniform1i(glGetUniformLocation(pass, name), samplerLoc++);
-			else
-				m_uLocs[name] = glGetUniformLocation(pass, name);
+			if (isSamplerType(type)) {
+				// samplers with layout(binding = N) already have their unit
+				GLint samplerUniform = glGetUniformLocation(pass, name);
+				GLint boundUnit = 0;
+				glGetUniformiv(pass, samplerUniform, &boundUnit);
+				if (boundUnit != 0)
+					continue;
+
+				// texture unit == index of the sampler in the pixel shader == index in the bind list
+				std::string samplerName(name, length);
+				samplerName = samplerName.substr(0, samplerName.find('['));
+
+				GLuint unit = samplerLoc;
+				auto declared = std::find(m_samplers.begin(), m_samplers.end(), samplerName);
+				if (declared != m_samplers.end())
+					unit = declared - m_samplers.begin();
+				else
+					samplerLoc++;
+
+				glUniform1i(samplerUniform, unit);
+			} else {
+				ActiveUniform uniform;
+				uniform.Location = glGetUniformLocation(pass, name);
+				uniform.ShadowSize = 0;
+
+				if (uniform.Location == -1) // uniform block members
+					continue;
+
+				m_uLocs[name] = m_uniforms.size();
+				m_uniforms.push_back(uniform);
+			}
+		}
+
+		glUseProgram(lastProgram);
+	}
+	void ShaderVariableContainer::m_buildSlots()
+	{
+		// variables were added, removed or reordered
+		m_packValues();
+
+		m_slots.resize(m_vars.size());
+		for (int i = 0; i < m_vars.size(); i++) {
+			auto loc = m_uLocs.find(m_vars[i]->Name);
+
+			m_slots[i].Variable = m_vars[i];
+			m_slots[i].Type = m_vars[i]->GetType();
+			m_slots[i].Uniform = (loc == m_uLocs.end()) ? -1 : loc->second;
+		}
+
+		for (int i = 0; i < m_itemValues.size(); i++) {
+			auto var = std::find(m_vars.begin(), m_vars.end(), m_itemValues[i].Variable);
+			if (var == m_vars.end()) {
+				m_itemValues.erase(m_itemValues.begin() + i);
+				i--;
+			} else
+				m_itemValues[i].Slot = var - m_vars.begin();
 		}
+		std::sort(m_itemValues.begin(), m_itemValues.end(), [](const ItemValue& a, const ItemValue& b) {
+			if (a.Item != b.Item)
+				return std::less<void*>()(a.Item, b.Item);
+			return a.Slot < b.Slot;
+		});
+
+		m_slotsDirty = false;
 	}
 	void ShaderVariableContainer::UpdateTextureList(const std::string& fragShader)
 	{
 		m_samplers.clear();
 
-		try {
-			std::regex re("[a-z]?sampler.+ .+;");
-			std::sregex_iterator next(fragShader.begin(), fragShader.end(), re);
-			std::sregex_iterator end;
-			while (next != end) {
-				std::smatch match = *next;
-				std::string name = match.str();
-				name = name.substr(name.find_first_of(' ') + 1);
-				name = name.substr(0, name.size() - 1);
-				m_samplers.push_back(name);
-				next++;
-			}
+		// only the declaration order is needed - the sampler types & the vertex shader samplers come from the reflection
+		std::stringstream ss(fragShader);
+		std::string token, prev;
+		bool isSampler = false;
+		while (ss >> token) {
+			if (token == "lowp" || token == "mediump" || token == "highp")
+				continue;
+
+			if (isSampler) {
+				m_samplers.push_back(token.substr(0, token.find_first_of(";[")));
+				isSampler = false;
+			} else if (prev == "uniform" && token.find("sampler") <= 1)
+				isSampler = true; // sampler2D, isampler2D, usampler2D, ...
+
+			prev = token;
 		}
-		catch (std::regex_error& e) {
-			// Syntax error in the regular expression
+	}
+	void ShaderVariableContainer::Hash(void* item, uint64_t& hash)
+	{
+		if (m_slotsDirty)
+			m_buildSlots();
+
+		auto itemValue = std::lower_bound(m_itemValues.begin(), m_itemValues.end(), item, [](const ItemValue& val, void* item) {
+			return std::less<void*>()(val.Item, item);
+		});
+
+		// same values as the ones that Bind(item) would upload
+		for (int i = 0; i < m_slots.size(); i++) {
+			const UniformSlot& slot = m_slots[i];
+
+			ShaderVariable* itemVar = nullptr;
+			if (itemValue != m_itemValues.end() && itemValue->Item == item && itemValue->Slot == i) {
+				itemVar = itemValue->Value;
+				itemValue++;
+			}
+
+			if (slot.Uniform == -1)
+				continue;
+
+			HashValue(hash, slot.Variable->Flags);
+			HashBytes(hash, m_getSlotValue(slot, itemVar, item), ShaderVariable::GetSize(slot.Type));
 		}
 	}
-	void ShaderVariableContainer::UpdateTexture(GLuint pass, GLuint unit)
+	char* ShaderVariableContainer::m_getSlotValue(const UniformSlot& slot, ShaderVariable* itemVar, void* item)
 	{
-		if (unit >= m_samplers.size())
-			return;
+		ShaderVariable* var = slot.Variable;
+
+		// update values if needed - function variables are evaluated once per frame by
+		// the FunctionVariableManager, pointers are copied again since they might point to a per-item value
+		SystemVariableManager::Instance().Update(var, item);
+		if (var->Function == FunctionShaderVariable::Pointer)
+			FunctionVariableManager::Update(var);
 
-		glUniform1i(glGetUniformLocation(pass, m_samplers[unit].c_str()), unit);
+		if (itemVar != nullptr && var->System == SystemShaderVariable::None && var->Function == FunctionShaderVariable::None)
+			return itemVar->Data;
+		return var->Data;
 	}
 	void ShaderVariableContainer::Bind(void* item)
 	{
-		for (int i = 0; i < m_vars.size(); i++) {
-			FunctionVariableManager::AddToList(m_vars[i]);
-			
-			if (m_uLocs.count(m_vars[i]->Name) == 0)
+		if (m_slotsDirty)
+			m_buildSlots();
+
+		// this item's values
+		auto itemValue = std::lower_bound(m_itemValues.begin(), m_itemValues.end(), item, [](const ItemValue& val, void* item) {
+			return std::less<void*>()(val.Item, item);
+		});
+
+		for (int i = 0; i < m_slots.size(); i++) {
+			const UniformSlot& slot = m_slots[i];
+			ShaderVariable* var = slot.Variable;
+
+			ShaderVariable* itemVar = nullptr;
+			if (itemValue != m_itemValues.end() && itemValue->Item == item && itemValue->Slot == i) {
+				itemVar = itemValue->Value;
+				itemValue++;
+			}
+
+			if (slot.Uniform == -1)
 				continue;
-			
-			GLint loc = m_uLocs[m_vars[i]->Name];
 
-			// update values if needed
-			SystemVariableManager::Instance().Update(m_vars[i], item);
-			FunctionVariableManager::Update(m_vars[i]);
+			ActiveUniform& uniform = m_uniforms[slot.Uniform];
+			GLint loc = uniform.Location;
 
-			// update uniform every time we bind this container
-			// TODO: maybe we shouldn't update variables that havent changed
-			ShaderVariable::ValueType type = m_vars[i]->GetType();
+			ShaderVariable::ValueType type = slot.Type;
+			char* value = m_getSlotValue(slot, itemVar, item);
 
-			// check the flags
-			if (m_vars[i]->Flags & (char)ShaderVariable::Flag::Inverse) {
+			// check the flags - inverse into a temporary so that the variable keeps its value
+			char inverse[sizeof(glm::mat4x4)];
+			if (var->Flags & (char)ShaderVariable::Flag::Inverse) {
 				if (type == ShaderVariable::ValueType::Float4x4) {
-					glm::mat4x4 matVal = glm::make_mat4x4(m_vars[i]->AsFloatPtr());
-					memcpy(m_vars[i]->Data, glm::value_ptr(glm::inverse(matVal)), sizeof(glm::mat4x4));
+					glm::mat4x4 matVal = glm::make_mat4x4((float*)value);
+					memcpy(inverse, glm::value_ptr(glm::inverse(matVal)), sizeof(glm::mat4x4));
+					value = inverse;
 				} else if (type == ShaderVariable::ValueType::Float3x3) {
-					glm::mat3x3 matVal = glm::make_mat3x3(m_vars[i]->AsFloatPtr());
-					memcpy(m_vars[i]->Data, glm::value_ptr(glm::inverse(matVal)), sizeof(glm::mat3x3));
+					glm::mat3x3 matVal = glm::make_mat3x3((float*)value);
+					memcpy(inverse, glm::value_ptr(glm::inverse(matVal)), sizeof(glm::mat3x3));
+					value = inverse;
 				} else if (type == ShaderVariable::ValueType::Float2x2) {
-					glm::mat2x2 matVal = glm::make_mat2x2(m_vars[i]->AsFloatPtr());
-					memcpy(m_vars[i]->Data, glm::value_ptr(glm::inverse(matVal)), sizeof(glm::mat2x2));
+					glm::mat2x2 matVal = glm::make_mat2x2((float*)value);
+					memcpy(inverse, glm::value_ptr(glm::inverse(matVal)), sizeof(glm::mat2x2));
+					value = inverse;
 				}
 			}
 
+			// skip the upload if the program already has this value
+			int size = ShaderVariable::GetSize(type);
+			if (uniform.ShadowSize == size && memcmp(uniform.Shadow, value, size) == 0) {
+				gl::CallCounter::Instance().Add(gl::CallCounter::Type::UniformSkip);
+				continue;
+			}
+			memcpy(uniform.Shadow, value, size);
+			uniform.ShadowSize = size;
+
 			switch (type) {
 			case ShaderVariable::ValueType::Boolean1:
 			case ShaderVariable::ValueType::Integer1:
-				glUniform1i(loc, m_vars[i]->AsInteger());
+				glUniform1i(loc, *(int*)value);
 				break;
 			case ShaderVariable::ValueType::Boolean2:
 			case ShaderVariable::ValueType::Integer2:
-				glUniform2iv(loc, 1, m_vars[i]->AsIntegerPtr());
+				glUniform2iv(loc, 1, (int*)value);
 				break;
 			case ShaderVariable::ValueType::Boolean3:
 			case ShaderVariable::ValueType::Integer3:
-				glUniform3iv(loc, 1, m_vars[i]->AsIntegerPtr());
+				glUniform3iv(loc, 1, (int*)value);
 				break;
 			case ShaderVariable::ValueType::Boolean4:
 			case ShaderVariable::ValueType::Integer4:
-				glUniform4iv(loc, 1, m_vars[i]->AsIntegerPtr());
+				glUniform4iv(loc, 1, (int*)value);
 				break;
 			case ShaderVariable::ValueType::Float1:
-				glUniform1f(loc, m_vars[i]->AsFloat());
+				glUniform1f(loc, *(float*)value);
 				break;
 			case ShaderVariable::ValueType::Float2:
-				glUniform2fv(loc, 1, m_vars[i]->AsFloatPtr());
+				glUniform2fv(loc, 1, (float*)value);
 				break;
 			case ShaderVariable::ValueType::Float3:
-				glUniform3fv(loc, 1, m_vars[i]->AsFloatPtr());
+				glUniform3fv(loc, 1, (float*)value);
 				break;
 			case ShaderVariable::ValueType::Float4:
-				glUniform4fv(loc, 1, m_vars[i]->AsFloatPtr());
+				glUniform4fv(loc, 1, (float*)value);
 				break;
 			case ShaderVariable::ValueType::Float2x2:
-				glUniformMatrix2fv(loc, 1, GL_FALSE, m_vars[i]->AsFloatPtr());
+				glUniformMatrix2fv(loc, 1, GL_FALSE, (float*)value);
 				break;
 			case ShaderVariable::ValueType::Float3x3:
-				glUniformMatrix3fv(loc, 1, GL_FALSE, m_vars[i]->AsFloatPtr());
+				glUniformMatrix3fv(loc, 1, GL_FALSE, (float*)value);
 				break;
 			case ShaderVariable::ValueType::Float4x4:
-				glUniformMatrix4fv(loc, 1, GL_FALSE, m_vars[i]->AsFloatPtr());
+				glUniformMatrix4fv(loc, 1, GL_FALSE, (float*)value);
 				break;
 			}
 		}
@@ -166,4 +416,11 @@ namespace ed
 				return true;
 		return false;
 	}
+	bool ShaderVariableContainer::UsesSystemVariable(SystemShaderVariable sys)
+	{
+		for (int i = 0; i < m_vars.size(); i++)
+			if (m_vars[i]->System == sys && m_uLocs.count(m_vars[i]->Name) > 0)
+				return true;
+		return false;
+	}
 }
\ No newline at end of file
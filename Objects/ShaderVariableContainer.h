@@ -1,5 +1,7 @@
 #pragma once
 #include "ShaderVariable.h"
+#include "FunctionVariableManager.h"
+#include "Hash.h"
 #include <vector>
 #include <map>
 
@@ -21,21 +23,72 @@ namespace ed
 		ShaderVariableContainer();
 		~ShaderVariableContainer();
 
-		inline void Add(ShaderVariable* var) { m_vars.push_back(var); }
+		void Add(ShaderVariable* var); // takes the ownership, var->Data is moved to the value arena
 		void AddCopy(ShaderVariable var);
 		void Remove(const char* name);
 
+		// per-item values - used instead of the variable's value when binding for that item
+		void SetItemValue(void* item, ShaderVariable* var, ShaderVariable* value);
+		void RemoveItemValue(void* item, ShaderVariable* var); // item == nullptr -> for all items
+		void RemoveItemValues(void* item);
+		char* GetValue(ShaderVariable* var, void* item); // the value that Bind(item) uploads
+
 		bool ContainsVariable(const char* name);
-		void UpdateUniformInfo(GLuint pass);
-		void UpdateTexture(GLuint pass, GLuint unit);
-		void UpdateTextureList(const std::string& fragShader);
+		bool UsesSystemVariable(SystemShaderVariable sys); // a variable with this system value is active in the last reflected program
+		void UpdateUniformInfo(GLuint pass); // reflect the active uniforms of a newly linked/bound program & assign the texture units
+		void UpdateTextureList(const std::string& fragShader); // must be called before UpdateUniformInfo()
 		void Bind(void* item = nullptr);
-		inline std::vector<ShaderVariable*>& GetVariables() { return m_vars; }
+		void Hash(void* item, uint64_t& hash); // hash of the values that Bind(item) would upload
+		inline bool UsesSystemBlock() { return m_usesSystemBlock; } // SHADERed_System block is used by the last reflected program
+		inline std::vector<ShaderVariable*>& GetVariables() { return m_vars; } // call Invalidate() after reordering, renaming or retyping the variables
+		inline const std::vector<ShaderVariable*>& GetVariables() const { return m_vars; }
+		inline void Invalidate() { m_slotsDirty = true; FunctionVariableManager::Invalidate(); }
 		inline const std::vector<std::string>& GetSamplerList() { return m_samplers; }
 
 	private:
 		std::vector<ShaderVariable*> m_vars;
-		std::map<std::string, GLint> m_uLocs;
 		std::vector<std::string> m_samplers;
+
+		// values of all the variables in one block, each variable gets a slot that can hold any type
+		struct alignas(16) ValueSlot
+		{
+			char Data[64];
+		};
+		std::vector<ValueSlot> m_values;
+		char* m_allocValue();
+		void m_packValues(); // lay the values out in m_vars order
+
+		// active uniforms of the last reflected program
+		struct ActiveUniform
+		{
+			GLint Location;
+			int ShadowSize;	// 0 if nothing has been uploaded yet
+			char Shadow[64];	// last uploaded value, enough for a float4x4
+		};
+		std::vector<ActiveUniform> m_uniforms;
+		std::map<std::string, int> m_uLocs; // name -> index in m_uniforms
+		bool m_usesSystemBlock;
+
+		// one slot per variable (in the same order as m_vars) so that Bind() doesn't have to look up the locations by name
+		struct UniformSlot
+		{
+			ShaderVariable* Variable;
+			ShaderVariable::ValueType Type;
+			int Uniform; // index in m_uniforms, -1 if the variable isn't used by the program
+		};
+		void m_buildSlots();
+		char* m_getSlotValue(const UniformSlot& slot, ShaderVariable* itemVar, void* item); // updates system & pointer values
+		std::vector<UniformSlot> m_slots;
+		bool m_slotsDirty;
+
+		// sorted by item and then by slot so that Bind() can walk them together with m_slots
+		struct ItemValue
+		{
+			void* Item;
+			ShaderVariable* Variable;
+			ShaderVariable* Value;
+			int Slot;
+		};
+		std::vector<ItemValue> m_itemValues;
 	};
 }
\ No newline at end of file
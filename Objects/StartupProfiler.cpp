@@ -0,0 +1,72 @@
+#include "StartupProfiler.h"
+#include "Logger.h"
+#include <stdio.h>
+
+namespace ed
+{
+	StartupProfiler::StartupProfiler()
+	{
+		m_enabled = false;
+		m_finished = false;
+		m_firstFrame = -1.0f;
+		m_start = Clock::now();
+	}
+	void StartupProfiler::Begin(const std::string& name)
+	{
+		if (!m_enabled || m_finished)
+			return;
+
+		Step step;
+		step.Name = name;
+		step.Depth = m_stack.size();
+		step.Start = m_elapsed();
+		step.Duration = 0.0f;
+
+		m_stack.push_back(m_steps.size());
+		m_steps.push_back(step);
+	}
+	void StartupProfiler::End()
+	{
+		if (!m_enabled || m_finished || m_stack.empty())
+			return;
+
+		Step& step = m_steps[m_stack.back()];
+		step.Duration = m_elapsed() - step.Start;
+		m_stack.pop_back();
+	}
+	void StartupProfiler::FirstFrame()
+	{
+		if (!m_enabled || m_firstFrame >= 0.0f)
+			return;
+
+		m_firstFrame = m_elapsed();
+	}
+	void StartupProfiler::Finish()
+	{
+		if (!m_enabled || m_finished)
+			return;
+
+		m_finished = true;
+		float total = m_elapsed();
+
+		printf("Startup time breakdown (ms since the start of the process):\n");
+		bool printedFirstFrame = false;
+		for (const auto& step : m_steps) {
+			if (!printedFirstFrame && m_firstFrame >= 0.0f && step.Start >= m_firstFrame) {
+				printf("%9.2fms  == first interactive frame ==\n", m_firstFrame);
+				printedFirstFrame = true;
+			}
+			printf("%9.2fms  %*s%s (%.2fms)\n", step.Start, step.Depth * 2, "", step.Name.c_str(), step.Duration);
+		}
+		if (!printedFirstFrame && m_firstFrame >= 0.0f)
+			printf("%9.2fms  == first interactive frame ==\n", m_firstFrame);
+		printf("%9.2fms  == startup finished ==\n", total);
+		fflush(stdout);
+
+		Logger::Get().Log("First interactive frame after " + std::to_string(m_firstFrame) + "ms, startup finished after " + std::to_string(total) + "ms");
+	}
+	float StartupProfiler::m_elapsed()
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - m_start).count();
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ed
+{
+	// time spent in each step of the startup (--profile-startup)
+	class StartupProfiler
+	{
+	public:
+		typedef std::chrono::high_resolution_clock Clock;
+
+		static inline StartupProfiler& Instance()
+		{
+			static StartupProfiler ret;
+			return ret;
+		}
+
+		inline void SetEnabled(bool enabled) { m_enabled = enabled; }
+		inline bool IsEnabled() { return m_enabled; }
+
+		// steps can be nested
+		void Begin(const std::string& name);
+		void End();
+
+		void FirstFrame();	// the first frame has been presented
+		void Finish();		// all the deferred work is done -> print the breakdown
+
+	private:
+		StartupProfiler();
+
+		struct Step
+		{
+			std::string Name;
+			int Depth;
+			float Start;	// ms since the process start
+			float Duration;
+		};
+
+		float m_elapsed();
+
+		bool m_enabled;
+		bool m_finished;
+		Clock::time_point m_start;
+		float m_firstFrame;
+		std::vector<Step> m_steps;
+		std::vector<int> m_stack;
+	};
+}
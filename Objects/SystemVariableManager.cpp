@@ -7,212 +7,210 @@ namespace ed
 	{
 		m_timer.Restart();
 		m_curState.FrameIndex = 0;
-		m_curGeoTransform.clear();
-		m_prevGeoTransform.clear();
+		m_frame[0].ViewValid = m_frame[1].ViewValid = false;
+		m_geoTransform[0].clear();
+		m_geoTransform[1].clear();
+		m_geoSlots.clear();
+		m_geoFreeSlots.clear();
+		m_lastGeoItem = nullptr;
+		m_lastGeoSlot = -1;
 		m_advTimer = 0;
 	}
 	void SystemVariableManager::CopyState()
 	{
 		memcpy(&m_prevState, &m_curState, sizeof(m_curState));
-		m_prevGeoTransform = m_curGeoTransform;
+
+		// the current buffers become the last frame's values
+		m_curFrame ^= 1;
+		m_frame[m_curFrame].ViewValid = false;
+	}
+	SystemVariableManager::FrameValues& SystemVariableManager::m_getFrame(int index, ValueGroup& state)
+	{
+		FrameValues& frame = m_frame[index];
+
+		bool viewChanged = !frame.ViewValid;
+		if (viewChanged) {
+			Camera* cam = Settings::Instance().Project.FPCamera ? (Camera*)&state.FPCam : (Camera*)&state.ArcCam;
+			frame.View = cam->GetMatrix();
+			frame.CameraPosition = glm::vec3(cam->GetPosition());
+			frame.CameraDirection = glm::vec3(cam->GetViewDirection());
+			frame.Time = GetTime();
+			frame.ViewValid = true;
+		}
+
+		if (viewChanged || frame.Viewport != state.Viewport) {
+			frame.Viewport = state.Viewport;
+			frame.Projection = glm::perspective(glm::radians(45.0f), frame.Viewport.x / frame.Viewport.y, 0.1f, 1000.0f);
+			frame.Orthographic = glm::ortho(0.0f, frame.Viewport.x, frame.Viewport.y, 0.0f, 0.1f, 1000.0f);
+			frame.ViewProjection = frame.Projection * frame.View;
+			frame.ViewOrthographic = frame.Orthographic * frame.View;
+		}
+
+		return frame;
+	}
+	int SystemVariableManager::m_getGeometrySlot(PipelineItem* item, bool create)
+	{
+		if (item == m_lastGeoItem)
+			return m_lastGeoSlot;
+
+		int slot = -1;
+		auto it = m_geoSlots.find(item);
+		if (it != m_geoSlots.end())
+			slot = it->second;
+		else if (create) {
+			if (m_geoFreeSlots.size() > 0) {
+				slot = m_geoFreeSlots.back();
+				m_geoFreeSlots.pop_back();
+			} else {
+				slot = m_geoTransform[0].size();
+				m_geoTransform[0].emplace_back();
+				m_geoTransform[1].emplace_back();
+			}
+
+			for (int i = 0; i < 2; i++) {
+				m_geoTransform[i][slot].Empty = true;
+				m_geoTransform[i][slot].Matrix = glm::mat4(1.0f);
+			}
+			m_geoSlots[item] = slot;
+		} else
+			return -1;
+
+		m_lastGeoItem = item;
+		m_lastGeoSlot = slot;
+
+		return slot;
+	}
+	glm::mat4 SystemVariableManager::m_getGeometryTransform(int index, PipelineItem* item)
+	{
+		int slot = m_getGeometrySlot(item, false);
+		if (slot == -1)
+			return glm::mat4(1.0f);
+		return m_geoTransform[index][slot].Matrix;
+	}
+	void SystemVariableManager::SetGeometryTransform(PipelineItem* item, const glm::vec3& scale, const glm::vec3& rota, const glm::vec3& pos)
+	{
+		GeometryTransform& trans = m_geoTransform[m_curFrame][m_getGeometrySlot(item, true)];
+
+		// only rebuild the matrix when the item was moved
+		if (!trans.Empty && trans.Scale == scale && trans.Rotation == rota && trans.Position == pos)
+			return;
+
+		trans.Empty = false;
+		trans.Scale = scale;
+		trans.Rotation = rota;
+		trans.Position = pos;
+		trans.Matrix = glm::translate(glm::mat4(1), pos) *
+			glm::yawPitchRoll(rota.y, rota.x, rota.z) *
+			glm::scale(glm::mat4(1.0f), scale);
+	}
+	void SystemVariableManager::RemoveGeometryTransform(PipelineItem* item)
+	{
+		auto it = m_geoSlots.find(item);
+		if (it == m_geoSlots.end())
+			return;
+
+		m_geoFreeSlots.push_back(it->second);
+		m_geoSlots.erase(it);
+
+		if (m_lastGeoItem == item) {
+			m_lastGeoItem = nullptr;
+			m_lastGeoSlot = -1;
+		}
+	}
+	void SystemVariableManager::GetUniformBlock(SystemUniformBlock& block)
+	{
+		const FrameValues& frame = m_getFrame(m_curFrame, m_curState);
+
+		block.View = frame.View;
+		block.Projection = frame.Projection;
+		block.ViewProjection = frame.ViewProjection;
+		block.Orthographic = frame.Orthographic;
+		block.ViewOrthographic = frame.ViewOrthographic;
+		block.CameraPosition = glm::vec4(frame.CameraPosition, 1);
+		block.CameraDirection = glm::vec4(frame.CameraDirection, 0);
+		block.Mouse = m_curState.Mouse;
+		block.MouseButton = m_curState.MouseButton;
+		block.ViewportSize = m_curState.Viewport;
+		block.MousePosition = m_curState.MousePosition;
+		block.Time = frame.Time;
+		block.TimeDelta = m_curState.DeltaTime;
+		block.FrameIndex = m_curState.FrameIndex;
+		block.Padding = 0;
+		block.KeysWASD = m_curState.WASD;
 	}
 	void SystemVariableManager::Update(ed::ShaderVariable* var, void* item)
 	{
 		if (var->System != ed::SystemShaderVariable::None) {
 			// we are using some system value so now is the right time to update its value
 			bool isLastFrame = var->Flags & (char)ShaderVariable::Flag::LastFrame;
-			
-			if (!isLastFrame) {
-				glm::mat4 rawMatrix;
-				switch (var->System) {
-					case ed::SystemShaderVariable::View:
-						rawMatrix = SystemVariableManager::Instance().GetViewMatrix();
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::Projection:
-						rawMatrix = SystemVariableManager::Instance().GetProjectionMatrix();
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::ViewProjection:
-						rawMatrix = SystemVariableManager::Instance().GetViewProjectionMatrix();
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::Orthographic:
-						rawMatrix = SystemVariableManager::Instance().GetOrthographicMatrix();
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::ViewOrthographic:
-						rawMatrix = SystemVariableManager::Instance().GetViewOrthographicMatrix();
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::GeometryTransform:
-						rawMatrix = SystemVariableManager::Instance().GetGeometryTransform((PipelineItem*)item);
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::ViewportSize:
-					{
-						glm::vec2 raw = SystemVariableManager::Instance().GetViewportSize();
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec2));
-					} break;
-					case ed::SystemShaderVariable::MousePosition:
-					{
-						glm::vec2 raw = SystemVariableManager::Instance().GetMousePosition();
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec2));
-					} break;
-					case ed::SystemShaderVariable::Mouse:
-					{
-						glm::vec4 raw = SystemVariableManager::Instance().GetMouse();
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec4));
-					} break;
-					case ed::SystemShaderVariable::MouseButton:
-					{
-						glm::vec4 raw = SystemVariableManager::Instance().GetMouseButton();
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec4));
-					} break;
-					case ed::SystemShaderVariable::Time:
-					{
-						float raw = SystemVariableManager::Instance().GetTime();
-						memcpy(var->Data, &raw, sizeof(float));
-					} break;
-					case ed::SystemShaderVariable::TimeDelta:
-					{
-						float raw = SystemVariableManager::Instance().GetTimeDelta();
-						memcpy(var->Data, &raw, sizeof(float));
-					} break;
-					case ed::SystemShaderVariable::FrameIndex:
-					{
-						unsigned int frame = SystemVariableManager::Instance().GetFrameIndex();
-						memcpy(var->Data, &frame, sizeof(unsigned int));
-					} break;
-					case ed::SystemShaderVariable::IsPicked:
-					{
-						bool raw = SystemVariableManager::Instance().IsPicked();
-						memcpy(var->Data, &raw, sizeof(bool));
-					} break;
-					case ed::SystemShaderVariable::CameraPosition:
-					{
-						glm::vec3 cam = SystemVariableManager::Instance().GetCamera()->GetPosition();
-						memcpy(var->Data, glm::value_ptr(glm::vec4(cam, 1)), sizeof(glm::vec4));
-					} break;
-					case ed::SystemShaderVariable::CameraPosition3:
-					{
-						glm::vec3 cam = SystemVariableManager::Instance().GetCamera()->GetPosition();
-						memcpy(var->Data, glm::value_ptr(cam), sizeof(glm::vec3));
-					} break;
-					case ed::SystemShaderVariable::CameraDirection3:
-					{
-						glm::vec3 cam = SystemVariableManager::Instance().GetCamera()->GetViewDirection();
-						memcpy(var->Data, glm::value_ptr(cam), sizeof(glm::vec3));
-					} break;
-					case ed::SystemShaderVariable::KeysWASD:
-					{
-						glm::ivec4 raw = SystemVariableManager::Instance().GetKeysWASD();
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::ivec4));
-					} break;
-					case ed::SystemShaderVariable::PluginVariable:
-					{
-						PluginSystemVariableData* pvData = &var->PluginSystemVarData;
-						pvData->Owner->UpdateSystemVariableValue(var->Data, pvData->Name, (plugin::VariableType)var->GetType(), isLastFrame);
-					} break;
-				}
-			} else {
-				glm::mat4 rawMatrix;
-				switch (var->System) {
-					case ed::SystemShaderVariable::View:
-						rawMatrix = Settings::Instance().Project.FPCamera ? m_prevState.FPCam.GetMatrix() : m_prevState.ArcCam.GetMatrix();;
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::Projection:
-						rawMatrix = glm::perspective(glm::radians(45.0f), m_prevState.Viewport.x / m_prevState.Viewport.y, 0.1f, 1000.0f);
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::ViewProjection: {
-						glm::mat4 view = Settings::Instance().Project.FPCamera ? m_prevState.FPCam.GetMatrix() : m_prevState.ArcCam.GetMatrix();;
-						glm::mat4 persp = glm::perspective(glm::radians(45.0f), m_prevState.Viewport.x / m_prevState.Viewport.y, 0.1f, 1000.0f);
-						
-						rawMatrix = persp * view;
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-					} break;
-					case ed::SystemShaderVariable::Orthographic:
-						rawMatrix = glm::ortho(0.0f, m_prevState.Viewport.x, m_prevState.Viewport.y, 0.0f, 0.1f, 1000.0f);;
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::ViewOrthographic: {
-						glm::mat4 view = Settings::Instance().Project.FPCamera ? m_prevState.FPCam.GetMatrix() : m_prevState.ArcCam.GetMatrix();;
-						glm::mat4 ortho = glm::ortho(0.0f, m_prevState.Viewport.x, m_prevState.Viewport.y, 0.0f, 0.1f, 1000.0f);;
-						rawMatrix = ortho * view;
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-					} break;
-					case ed::SystemShaderVariable::GeometryTransform:
-						rawMatrix = m_prevGeoTransform[(PipelineItem*)item];
-						memcpy(var->Data, glm::value_ptr(rawMatrix), sizeof(glm::mat4));
-						break;
-					case ed::SystemShaderVariable::ViewportSize:
-					{
-						glm::vec2 raw = m_prevState.Viewport;
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec2));
-					} break;
-					case ed::SystemShaderVariable::MousePosition:
-					{
-						glm::vec2 raw = m_prevState.MousePosition;
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec2));
-					} break;
-					case ed::SystemShaderVariable::Mouse:
-					{
-						glm::vec4 raw = m_prevState.Mouse;
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec4));
-					} break;
-					case ed::SystemShaderVariable::MouseButton:
-					{
-						glm::vec4 raw = m_prevState.MouseButton;
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::vec4));
-					} break;
-					case ed::SystemShaderVariable::Time:
-					{
-						float raw = SystemVariableManager::Instance().GetTime();
-						memcpy(var->Data, &raw, sizeof(float));
-					} break;
-					case ed::SystemShaderVariable::TimeDelta:
-					{
-						float raw = m_prevState.DeltaTime;
-						memcpy(var->Data, &raw, sizeof(float));
-					} break;
-					case ed::SystemShaderVariable::FrameIndex:
-					{
-						unsigned int frame = m_prevState.FrameIndex;
-						memcpy(var->Data, &frame, sizeof(unsigned int));
-					} break;
-					case ed::SystemShaderVariable::IsPicked:
-					{
-						bool raw = m_prevState.IsPicked;
-						memcpy(var->Data, &raw, sizeof(bool));
-					} break;
-					case ed::SystemShaderVariable::CameraPosition:
-					{
-						glm::vec3 cam = (Settings::Instance().Project.FPCamera ? (Camera*)&m_prevState.FPCam : (Camera*)&m_prevState.ArcCam)->GetPosition();
-						memcpy(var->Data, glm::value_ptr(glm::vec4(cam, 1)), sizeof(glm::vec4));
-					} break;
-					case ed::SystemShaderVariable::CameraPosition3:
-					{
-						glm::vec3 cam = (Settings::Instance().Project.FPCamera ? (Camera*)&m_prevState.FPCam : (Camera*)&m_prevState.ArcCam)->GetPosition();
-						memcpy(var->Data, glm::value_ptr(cam), sizeof(glm::vec3));
-					} break;
-					case ed::SystemShaderVariable::CameraDirection3:
-					{
-						glm::vec3 cam = (Settings::Instance().Project.FPCamera ? (Camera*)&m_prevState.FPCam : (Camera*)&m_prevState.ArcCam)->GetViewDirection();
-						memcpy(var->Data, glm::value_ptr(cam), sizeof(glm::vec3));
-					} break;
-					case ed::SystemShaderVariable::KeysWASD:
-					{
-						glm::ivec4 raw = m_prevState.WASD;
-						memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::ivec4));
-					} break;
-					case ed::SystemShaderVariable::PluginVariable:
-					{
-						PluginSystemVariableData* pvData = &var->PluginSystemVarData;
-						pvData->Owner->UpdateSystemVariableValue(var->Data, pvData->Name, (plugin::VariableType)var->GetType(), isLastFrame);
-					} break;
-				}
+			int frameIndex = isLastFrame ? (m_curFrame ^ 1) : m_curFrame;
+			ValueGroup& state = isLastFrame ? m_prevState : m_curState;
+
+			switch (var->System) {
+				case ed::SystemShaderVariable::View:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).View), sizeof(glm::mat4));
+					break;
+				case ed::SystemShaderVariable::Projection:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).Projection), sizeof(glm::mat4));
+					break;
+				case ed::SystemShaderVariable::ViewProjection:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).ViewProjection), sizeof(glm::mat4));
+					break;
+				case ed::SystemShaderVariable::Orthographic:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).Orthographic), sizeof(glm::mat4));
+					break;
+				case ed::SystemShaderVariable::ViewOrthographic:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).ViewOrthographic), sizeof(glm::mat4));
+					break;
+				case ed::SystemShaderVariable::GeometryTransform:
+				{
+					glm::mat4 raw = m_getGeometryTransform(frameIndex, (PipelineItem*)item);
+					memcpy(var->Data, glm::value_ptr(raw), sizeof(glm::mat4));
+				} break;
+				case ed::SystemShaderVariable::ViewportSize:
+					memcpy(var->Data, glm::value_ptr(state.Viewport), sizeof(glm::vec2));
+					break;
+				case ed::SystemShaderVariable::MousePosition:
+					memcpy(var->Data, glm::value_ptr(state.MousePosition), sizeof(glm::vec2));
+					break;
+				case ed::SystemShaderVariable::Mouse:
+					memcpy(var->Data, glm::value_ptr(state.Mouse), sizeof(glm::vec4));
+					break;
+				case ed::SystemShaderVariable::MouseButton:
+					memcpy(var->Data, glm::value_ptr(state.MouseButton), sizeof(glm::vec4));
+					break;
+				case ed::SystemShaderVariable::Time:
+					memcpy(var->Data, &m_getFrame(m_curFrame, m_curState).Time, sizeof(float));
+					break;
+				case ed::SystemShaderVariable::TimeDelta:
+					memcpy(var->Data, &state.DeltaTime, sizeof(float));
+					break;
+				case ed::SystemShaderVariable::FrameIndex:
+					memcpy(var->Data, &state.FrameIndex, sizeof(unsigned int));
+					break;
+				case ed::SystemShaderVariable::IsPicked:
+					memcpy(var->Data, &state.IsPicked, sizeof(bool));
+					break;
+				case ed::SystemShaderVariable::CameraPosition:
+					memcpy(var->Data, glm::value_ptr(glm::vec4(m_getFrame(frameIndex, state).CameraPosition, 1)), sizeof(glm::vec4));
+					break;
+				case ed::SystemShaderVariable::CameraPosition3:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).CameraPosition), sizeof(glm::vec3));
+					break;
+				case ed::SystemShaderVariable::CameraDirection3:
+					memcpy(var->Data, glm::value_ptr(m_getFrame(frameIndex, state).CameraDirection), sizeof(glm::vec3));
+					break;
+				case ed::SystemShaderVariable::KeysWASD:
+					memcpy(var->Data, glm::value_ptr(state.WASD), sizeof(glm::ivec4));
+					break;
+				case ed::SystemShaderVariable::PassSlice:
+					memcpy(var->Data, glm::value_ptr(m_curState.PassSlice), sizeof(glm::ivec4));
+					break;
+				case ed::SystemShaderVariable::PluginVariable:
+				{
+					PluginSystemVariableData* pvData = &var->PluginSystemVarData;
+					pvData->Owner->UpdateSystemVariableValue(var->Data, pvData->Name, (plugin::VariableType)var->GetType(), isLastFrame);
+				} break;
 			}
 		}
 	}
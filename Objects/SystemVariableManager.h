@@ -10,9 +10,43 @@
 #include "Settings.h"
 
 #include <unordered_map>
+#include <vector>
+
+#define SYSTEM_UBO_NAME "SHADERed_System" // name of the uniform block (cbuffer) that shaders can declare to read the system values
+#define SYSTEM_UBO_BINDING 35 // reserved uniform buffer binding point (GL 3.3 guarantees at least 36)
 
 namespace ed
 {
+	// std140 layout of the SHADERed_System uniform block:
+	// layout(std140) uniform SHADERed_System {
+	//		mat4 View, Projection, ViewProjection, Orthographic, ViewOrthographic;
+	//		vec4 CameraPosition, CameraDirection, Mouse, MouseButton;
+	//		vec2 ViewportSize, MousePosition;
+	//		float Time, TimeDelta;
+	//		int FrameIndex, Padding;
+	//		ivec4 KeysWASD;
+	// };
+	struct SystemUniformBlock
+	{
+		glm::mat4 View;
+		glm::mat4 Projection;
+		glm::mat4 ViewProjection;
+		glm::mat4 Orthographic;
+		glm::mat4 ViewOrthographic;
+		glm::vec4 CameraPosition;
+		glm::vec4 CameraDirection;
+		glm::vec4 Mouse;
+		glm::vec4 MouseButton;
+		glm::vec2 ViewportSize;
+		glm::vec2 MousePosition;
+		float Time;
+		float TimeDelta;
+		int FrameIndex;
+		int Padding;
+		glm::ivec4 KeysWASD;
+	};
+	static_assert(sizeof(SystemUniformBlock) == 432, "SystemUniformBlock doesn't match the std140 layout");
+
 	// singleton used for getting some system-level values
 	class SystemVariableManager
 	{
@@ -31,8 +65,11 @@ namespace ed
 			m_curState.Viewport = glm::vec2(0,1);
 			m_curState.MousePosition = glm::vec2(0,0);
 			m_curState.DeltaTime = 0.0f;
-			m_curGeoTransform.clear();
-			m_prevGeoTransform.clear();
+			m_curState.PassSlice = glm::ivec4(0, 1, 0, 0);
+			m_curFrame = 0;
+			m_frame[0].ViewValid = m_frame[1].ViewValid = false;
+			m_lastGeoItem = nullptr;
+			m_lastGeoSlot = -1;
 		}
 
 		static inline ed::ShaderVariable::ValueType GetType(ed::SystemShaderVariable sysVar)
@@ -56,40 +93,42 @@ namespace ed
 				case ed::SystemShaderVariable::CameraPosition3: return ed::ShaderVariable::ValueType::Float3;
 				case ed::SystemShaderVariable::CameraDirection3: return ed::ShaderVariable::ValueType::Float3;
 				case ed::SystemShaderVariable::KeysWASD: return ed::ShaderVariable::ValueType::Integer4;
+				case ed::SystemShaderVariable::PassSlice: return ed::ShaderVariable::ValueType::Integer4;
 			}
 
 			return ed::ShaderVariable::ValueType::Float1;
 		}
 
 		void Update(ed::ShaderVariable* var, void* item = nullptr);
+		void GetUniformBlock(SystemUniformBlock& block);
 
 		void Reset();
 		void CopyState();
 
+		// camera could've moved since the last frame -> rebuild the frame-global values on first use
+		inline void BeginFrame() { m_frame[m_curFrame].ViewValid = false; }
+
 		inline Camera* GetCamera() { return Settings::Instance().Project.FPCamera ? (Camera*)&m_curState.FPCam : (Camera*)&m_curState.ArcCam; }
 		inline glm::mat4 GetViewMatrix() { return Settings::Instance().Project.FPCamera ? m_curState.FPCam.GetMatrix() : m_curState.ArcCam.GetMatrix(); }
-		inline glm::mat4 GetProjectionMatrix() { return glm::perspective(glm::radians(45.0f), m_curState.Viewport.x / m_curState.Viewport.y, 0.1f, 1000.0f); }
-		inline glm::mat4 GetOrthographicMatrix() { return glm::ortho(0.0f, m_curState.Viewport.x, m_curState.Viewport.y, 0.0f, 0.1f, 1000.0f); }
-		inline glm::mat4 GetViewProjectionMatrix() { return GetProjectionMatrix() * GetViewMatrix(); }
-		inline glm::mat4 GetViewOrthographicMatrix() { return GetOrthographicMatrix() * GetViewMatrix(); }
-		inline glm::mat4 GetGeometryTransform(PipelineItem* item) { return m_curGeoTransform[item]; }
+		inline glm::mat4 GetProjectionMatrix() { return m_getFrame(m_curFrame, m_curState).Projection; }
+		inline glm::mat4 GetOrthographicMatrix() { return m_getFrame(m_curFrame, m_curState).Orthographic; }
+		inline glm::mat4 GetViewProjectionMatrix() { return m_getFrame(m_curFrame, m_curState).ViewProjection; }
+		inline glm::mat4 GetViewOrthographicMatrix() { return m_getFrame(m_curFrame, m_curState).ViewOrthographic; }
+		inline glm::mat4 GetGeometryTransform(PipelineItem* item) { return m_getGeometryTransform(m_curFrame, item); }
 		inline glm::vec2 GetViewportSize() { return m_curState.Viewport; }
 		inline glm::ivec4  GetKeysWASD() { return m_curState.WASD; }
 		inline glm::vec2 GetMousePosition() { return m_curState.MousePosition; }
 		inline glm::vec4 GetMouse() { return m_curState.Mouse; }
 		inline glm::vec4 GetMouseButton() { return m_curState.MouseButton; }
+		inline glm::ivec4 GetPassSlice() { return m_curState.PassSlice; }
 		inline unsigned int GetFrameIndex() { return m_curState.FrameIndex; }
 		inline float GetTime() { return m_timer.GetElapsedTime() + m_advTimer; }
 		inline eng::Timer& GetTimeClock() { return m_timer; }
 		inline float GetTimeDelta() { return m_curState.DeltaTime; }
 		inline bool IsPicked() { return m_curState.IsPicked; }
 
-		inline void SetGeometryTransform(PipelineItem* item, const glm::vec3& scale, const glm::vec3& rota, const glm::vec3& pos)
-		{
-			m_curGeoTransform[item] = glm::translate(glm::mat4(1), pos) *
-				glm::yawPitchRoll(rota.y, rota.x, rota.z) * 
-				glm::scale(glm::mat4(1.0f), scale);
-		}
+		void SetGeometryTransform(PipelineItem* item, const glm::vec3& scale, const glm::vec3& rota, const glm::vec3& pos);
+		void RemoveGeometryTransform(PipelineItem* item); // frees the item's slot
 		inline void SetViewportSize(float x, float y) { m_curState.Viewport = glm::vec2(x, y); }
 		inline void SetMousePosition(float x, float y) { m_curState.MousePosition = glm::vec2(x, y); }
 		inline void SetMouse(float x, float y, float left, float right) { m_curState.Mouse = glm::vec4(x, y, left, right); }
@@ -98,6 +137,7 @@ namespace ed
 		inline void SetPicked(bool picked) { m_curState.IsPicked = picked; }
 		inline void SetKeysWASD(int w, int a, int s, int d) { m_curState.WASD = glm::ivec4(w, a, s, d); }
 		inline void SetFrameIndex(unsigned int ind) { m_curState.FrameIndex = ind; }
+		inline void SetPassSlice(int index, int count, int firstGroup = 0, int groupCount = 0) { m_curState.PassSlice = glm::ivec4(index, count, firstGroup, groupCount); }
 
 		inline void AdvanceTimer(float t) { m_advTimer += t; }
 
@@ -115,9 +155,39 @@ namespace ed
 			unsigned int FrameIndex;
 			glm::ivec4 WASD;
 			glm::vec4 Mouse, MouseButton;
+			glm::ivec4 PassSlice;
 		} m_prevState, m_curState;
 
+		// values that are the same for every pass/item in a frame
+		struct FrameValues
+		{
+			bool ViewValid;
+			glm::mat4 View;
+			glm::vec3 CameraPosition, CameraDirection;
+			float Time;
+
+			glm::vec2 Viewport; // projection matrices are rebuilt only when the viewport changes
+			glm::mat4 Projection, ViewProjection, Orthographic, ViewOrthographic;
+		};
+		FrameValues& m_getFrame(int index, ValueGroup& state);
+
+		struct GeometryTransform
+		{
+			bool Empty;
+			glm::vec3 Scale, Rotation, Position;
+			glm::mat4 Matrix;
+		};
+		int m_getGeometrySlot(PipelineItem* item, bool create);
+		glm::mat4 m_getGeometryTransform(int index, PipelineItem* item);
+
+		// [m_curFrame] -> current frame, [m_curFrame ^ 1] -> last frame
+		int m_curFrame;
+		FrameValues m_frame[2];
+		std::vector<GeometryTransform> m_geoTransform[2];
 
-		std::unordered_map<PipelineItem*, glm::mat4> m_curGeoTransform, m_prevGeoTransform;
+		std::unordered_map<PipelineItem*, int> m_geoSlots;
+		std::vector<int> m_geoFreeSlots;
+		PipelineItem* m_lastGeoItem; // Get() usually follows Set() for the same item
+		int m_lastGeoSlot;
 	};
 }
\ No newline at end of file
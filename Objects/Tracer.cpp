@@ -0,0 +1,103 @@
+#include "Tracer.h"
+#include "Logger.h"
+
+#include <fstream>
+#include <string.h>
+
+namespace ed
+{
+	Tracer::Tracer()
+	{
+		m_enabled = false;
+		m_start = Clock::now();
+	}
+	void Tracer::Start()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_events.clear();
+		m_start = Clock::now();
+		m_enabled = true;
+	}
+	void Tracer::Stop()
+	{
+		m_enabled = false;
+	}
+	bool Tracer::Save(const std::string& file)
+	{
+		std::ofstream out(file);
+		if (!out.is_open()) {
+			Logger::Get().Log("Failed to save the trace to " + file, true);
+			return false;
+		}
+
+		auto escape = [](const char* str) -> std::string {
+			std::string ret;
+			for (; *str != 0; str++) {
+				if (*str == '"' || *str == '\\')
+					ret += '\\';
+				if ((unsigned char)*str >= 0x20)
+					ret += *str;
+			}
+			return ret;
+		};
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+
+		for (int i = 0; i < m_threadNames.size(); i++)
+			out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"" << escape(m_threadNames[i].c_str()) << "\"}}," << std::endl;
+
+		for (const auto& evt : m_events)
+			out << "{\"name\":\"" << escape(evt.Name) << "\",\"cat\":\"SHADERed\",\"ph\":\"X\",\"pid\":1,\"tid\":" << evt.Thread << ",\"ts\":" << evt.Start << ",\"dur\":" << evt.Duration << "}," << std::endl;
+
+		// the trailing comma is not allowed in JSON
+		out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SHADERed\"}}" << std::endl;
+		out << "]}" << std::endl;
+
+		Logger::Get().Log("Saved " + std::to_string(m_events.size()) + " trace events to " + file);
+
+		return true;
+	}
+	void Tracer::SetThreadName(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_threadNames[m_getThreadID()] = name;
+	}
+	void Tracer::AddEvent(const char* name, const Clock::time_point& start, const Clock::time_point& end)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_enabled)
+			return;
+
+		if (m_events.size() >= TRACE_MAX_EVENTS) {
+			m_enabled = false;
+			Logger::Get().Log("Trace event limit reached - stopped tracing", true);
+			return;
+		}
+
+		Event evt;
+		strncpy(evt.Name, name, sizeof(evt.Name) - 1);
+		evt.Name[sizeof(evt.Name) - 1] = 0;
+		evt.Start = std::chrono::duration_cast<std::chrono::microseconds>(start - m_start).count();
+		evt.Duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+		evt.Thread = m_getThreadID();
+		m_events.push_back(evt);
+	}
+	int Tracer::m_getThreadID()
+	{
+		std::thread::id id = std::this_thread::get_id();
+
+		auto it = m_threads.find(id);
+		if (it != m_threads.end())
+			return it->second;
+
+		int ret = m_threadNames.size();
+		m_threads[id] = ret;
+		m_threadNames.push_back(ret == 0 ? "Main" : ("Thread " + std::to_string(ret)));
+
+		return ret;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+#define TRACE_MAX_EVENTS 1000000
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+// measure the time until the end of the current scope (name must stay alive until then)
+#define TRACE_ZONE(name) ed::TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+
+namespace ed
+{
+	// records the time spent in the scoped zones and saves it in the Chrome trace event format (chrome://tracing, Perfetto)
+	class Tracer
+	{
+	public:
+		typedef std::chrono::high_resolution_clock Clock;
+
+		static inline Tracer& Instance()
+		{
+			static Tracer ret;
+			return ret;
+		}
+
+		void Start();
+		void Stop();
+		inline bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+		bool Save(const std::string& file);
+
+		// name of the calling thread in the trace
+		void SetThreadName(const std::string& name);
+
+		void AddEvent(const char* name, const Clock::time_point& start, const Clock::time_point& end);
+
+	private:
+		Tracer();
+
+		struct Event
+		{
+			char Name[64];
+			long long Start;	// microseconds since Start()
+			long long Duration;
+			int Thread;
+		};
+
+		int m_getThreadID(); // m_mutex has to be locked
+
+		std::atomic<bool> m_enabled;
+		std::mutex m_mutex;
+		Clock::time_point m_start;
+		std::vector<Event> m_events;
+		std::unordered_map<std::thread::id, int> m_threads;
+		std::vector<std::string> m_threadNames;
+	};
+
+	class TraceZone
+	{
+	public:
+		inline TraceZone(const char* name) : m_name(nullptr)
+		{
+			if (Tracer::Instance().IsEnabled()) {
+				m_name = name;
+				m_start = Tracer::Clock::now();
+			}
+		}
+		inline ~TraceZone()
+		{
+			if (m_name != nullptr)
+				Tracer::Instance().AddEvent(m_name, m_start, Tracer::Clock::now());
+		}
+
+	private:
+		const char* m_name;
+		Tracer::Clock::time_point m_start;
+	};
+}
@@ -7,6 +7,7 @@
 #include "../Objects/ShaderTranscompiler.h"
 #include "../Objects/ThemeContainer.h"
 #include "../Objects/KeyboardShortcuts.h"
+#include "../Objects/Tracer.h"
 
 #include <iostream>
 #include <fstream>
@@ -745,6 +746,8 @@ namespace ed
 	}
 	void CodeEditorUI::m_autoRecompiler()
 	{		
+		Tracer::Instance().SetThreadName("Auto recompiler");
+
 		while (m_autoRecompilerRunning) {
 			std::this_thread::sleep_for(std::chrono::milliseconds(200));
 
@@ -752,6 +755,8 @@ namespace ed
 			if (!m_autoRecompilerMutex.try_lock())
 				continue;
 
+			TRACE_ZONE("Auto recompile");
+
 			m_ariiList.clear();
 			for (int i = 0; i < m_editor.size(); i++) {
 				if (!m_editor[i].IsTextChanged())
@@ -884,6 +889,8 @@ namespace ed
 	}
 	void CodeEditorUI::m_trackWorker()
 	{
+		Tracer::Instance().SetThreadName("File tracker");
+
 		std::string curProject = m_data->Parser.GetOpenedFile();
 
 		std::vector<PipelineItem*> passes = m_data->Pipeline.GetList();
@@ -906,7 +913,7 @@ namespace ed
 		std::vector<int> notifyIDs;
 		
 		if (notifyEngine < 0) {
-			// TODO: log from this thread!
+			Logger::Get().Log("Failed to initialize inotify - file changes won't be tracked", true);
 			return;
 		}
 
@@ -1145,8 +1152,10 @@ namespace ed
 						NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
 						NULL);
 
-					if (hDirs[i] == INVALID_HANDLE_VALUE)
+					if (hDirs[i] == INVALID_HANDLE_VALUE) {
+						Logger::Get().Log("Failed to track file changes in " + paths[i], true);
 						return;
+					}
 
 					pOverlap[i].OffsetHigh = 0;
 					pOverlap[i].hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
@@ -1195,6 +1204,8 @@ namespace ed
 
 							for (int i = 0; i < allFiles.size(); i++)
 								if (allFiles[i] == updatedFile) {
+									Logger::Get().Log("Detected changes in " + updatedFile);
+
 									// did we modify this file through "Compile" option?
 									bool shouldBeIgnored = false;
 									for (int j = 0; j < m_trackIgnore.size(); j++)
@@ -1264,6 +1275,8 @@ namespace ed
 
 						for (int i = 0; i < allFiles.size(); i++)
 							if (allFiles[i] == updatedFile) {
+								Logger::Get().Log("Detected changes in " + updatedFile);
+
 								// did we modify this file through "Compile" option?
 								bool shouldBeIgnored = false;
 								for (int j = 0; j < m_trackIgnore.size(); j++)
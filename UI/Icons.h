@@ -1,6 +1,7 @@
 #pragma once
 
 // ICON CODES
+// new icons also have to be added to UI_ICON_ALL - only those glyphs are put in the font atlas
 // TODO: maybe move this to an external .txt file so that everyone can modify it?
 #define UI_ICON_COLLAPSE u8"\uea96"
 #define UI_ICON_EXPAND u8"\uea9a"
@@ -61,4 +62,17 @@
 #define UI_ICON_FILE_TEXT u8"\ueb2a"
 #define UI_ICON_FILE_CODE u8"\ueb0c"
 #define UI_ICON_FILE_AUDIO u8"\ueb09"
-#define UI_ICON_SEARCH2 u8"\ued11"
\ No newline at end of file
+#define UI_ICON_SEARCH2 u8"\ued11"
+
+// all the icons used by the UI
+#define UI_ICON_ALL \
+	UI_ICON_COLLAPSE UI_ICON_EXPAND UI_ICON_UP UI_ICON_DOWN UI_ICON_MAXIMIZE UI_ICON_CAMERA \
+	UI_ICON_CODE UI_ICON_SAVE UI_ICON_ERROR UI_ICON_EXCLAMATION UI_ICON_EYE UI_ICON_EYE_BLOCKED \
+	UI_ICON_FOLDER_OPEN UI_ICON_CUBE UI_ICON_DOCUMENT_FOLDER UI_ICON_GEAR UI_ICON_IMAGE UI_ICON_PIXELS \
+	UI_ICON_REFRESH UI_ICON_TRANSPARENT UI_ICON_CHECK UI_ICON_WARNING UI_ICON_ARROW_DOWN UI_ICON_ARROW_UP \
+	UI_ICON_ADD UI_ICON_REMOVE UI_ICON_CLOSE UI_ICON_COPY UI_ICON_CUT UI_ICON_DELETE \
+	UI_ICON_EDIT UI_ICON_FILE UI_ICON_IMAGE2 UI_ICON_LOCK UI_ICON_MUTE UI_ICON_NEXT \
+	UI_ICON_PAUSE UI_ICON_PLAY UI_ICON_PRESS UI_ICON_MUSIC UI_ICON_SEARCH UI_ICON_UNLOCK \
+	UI_ICON_VOLUME UI_ICON_ZOOM_IN UI_ICON_ZOOM_OUT UI_ICON_USER UI_ICON_VIDEO UI_ICON_LOGIN \
+	UI_ICON_LOGOUT UI_ICON_FX UI_ICON_REDO UI_ICON_UNDO UI_ICON_FILE_WAVE UI_ICON_FILE_VIDEO \
+	UI_ICON_FILE_IMAGE UI_ICON_FILE_FILE UI_ICON_FILE_TEXT UI_ICON_FILE_CODE UI_ICON_FILE_AUDIO UI_ICON_SEARCH2
@@ -29,6 +29,8 @@ namespace ed
 
         m_items.push_back(i);
         m_zoom.push_back(Magnifier()); // TODO: only create magnifier tools for textures to lower down GPU resource usage
+
+        m_updateWatched();
     }
 	void ObjectPreviewUI::OnEvent(const SDL_Event& e)
     {
@@ -150,6 +152,7 @@ namespace ed
 							glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // resize
 							glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+							m_data->Objects.MarkModified();
 							m_data->Parser.ModifyProject();
 						}
 						if (ImGui::Button("CLEAR##objprev_clearbuf")) {
@@ -159,6 +162,7 @@ namespace ed
 							glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // resize
 							glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+							m_data->Objects.MarkModified();
 							m_data->Parser.ModifyProject();
 						}
 
@@ -191,6 +195,7 @@ namespace ed
 										glBufferData(GL_UNIFORM_BUFFER, buf->Size, buf->Data, GL_STATIC_DRAW); // allocate 0 bytes of memory
 										glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+										m_data->Objects.MarkModified();
 										m_data->Parser.ModifyProject();
 									}
 									curColOffset += ShaderVariable::GetSize(item->CachedFormat[j]);
@@ -227,6 +232,7 @@ namespace ed
 
             if (!item->IsOpen) {
                 m_items.erase(m_items.begin() + i);
+                m_updateWatched();
                 i--;
             }
         }
@@ -314,5 +320,19 @@ namespace ed
                 i--;
             }
         }
+
+        m_updateWatched();
+    }
+    void ObjectPreviewUI::m_updateWatched()
+    {
+        std::vector<GLuint> textures, buffers;
+        for (const mItem& item : m_items) {
+            if (item.Buffer != nullptr)
+                buffers.push_back(((BufferObject*)item.Buffer)->ID);
+            else if (item.Plugin == nullptr && item.Audio == nullptr)
+                textures.push_back(item.Texture);
+        }
+
+        m_data->Renderer.GetGraph().SetWatched(textures, buffers);
     }
 }
\ No newline at end of file
@@ -25,7 +25,7 @@ namespace ed
         void Open(const std::string& name, float w, float h, unsigned int item, bool isCube = false, void* rt = nullptr, void* audio = nullptr, void* buffer = nullptr, void* plugin = nullptr);
 
         inline bool ShouldRun() { return m_items.size() > 0; }
-        inline void CloseAll() { m_items.clear(); }
+        inline void CloseAll() { m_items.clear(); m_updateWatched(); }
         void Close(const std::string& name);
 
 	protected:
@@ -52,6 +52,7 @@ namespace ed
         sf::Clock m_bufUpdateClock;
         bool m_drawBufferElement(int row, int col, void *data, ShaderVariable::ValueType type);
         std::vector<mItem> m_items;
+        void m_updateWatched(); // opened textures & buffers are always rendered (RenderGraph)
         ed::AudioAnalyzer m_audioAnalyzer;
         float m_samples[512], m_fft[512];
         
@@ -707,6 +707,21 @@ namespace ed
 			ImGui::PopItemFlag();
 		}
 
+		/* SKIP UNUSED PASSES: */
+		ImGui::Text("Skip the passes whose output isn't used: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optp_skip_unused", &settings->Preview.SkipUnusedPasses);
+
+		/* CACHE PASSES: */
+		ImGui::Text("Reuse the output of the passes whose inputs didn't change: ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optp_cache_passes", &settings->Preview.CachePasses);
+
+		/* GL CALL COUNTERS: */
+		ImGui::Text("Count the GL calls (shown in the status bar): ");
+		ImGui::SameLine();
+		ImGui::Checkbox("##optp_gl_call_counters", &settings->Preview.GLCallCounters);
+
 	}
 	void OptionsUI::m_renderPlugins()
 	{
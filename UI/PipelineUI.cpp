@@ -253,9 +253,7 @@ namespace ed
 				if (owner != nullptr)
 					owner->Owner->MovePipelineItemUp(owner->PluginData, owner->Type, items[index]->Name);
 
-				ed::PipelineItem* temp = items[index - 1];
-				items[index - 1] = items[index];
-				items[index] = temp;
+				m_data->Pipeline.Move(items[index], index - 1);
 
 				if (props->HasItemSelected()) {
 					if (oldPropertyItemName == items[index - 1]->Name)
@@ -277,9 +275,7 @@ namespace ed
 				if (owner != nullptr)
 					owner->Owner->MovePipelineItemDown(owner->PluginData, owner->Type, items[index]->Name);
 
-				ed::PipelineItem* temp = items[index + 1];
-				items[index + 1] = items[index];
-				items[index] = temp;
+				m_data->Pipeline.Move(items[index], index + 1);
 
 				if (props->HasItemSelected()) {
 					if (oldPropertyItemName == items[index + 1]->Name)
@@ -414,6 +410,21 @@ namespace ed
 					m_modalItem = items[index];
 				}
 
+				if (!isPlugin && ImGui::BeginMenu("Dependencies")) {
+					m_renderDependencies(items[index]);
+					ImGui::EndMenu();
+				}
+
+				if (items[index]->Type == PipelineItem::ItemType::ShaderPass) {
+					pipe::ShaderPass* passData = (pipe::ShaderPass*)items[index]->Data;
+					if (ImGui::MenuItem("Freeze", nullptr, passData->Frozen))
+						passData->Frozen = !passData->Frozen;
+				} else if (items[index]->Type == PipelineItem::ItemType::ComputePass) {
+					pipe::ComputePass* passData = (pipe::ComputePass*)items[index]->Data;
+					if (ImGui::MenuItem("Freeze", nullptr, passData->Frozen))
+						passData->Frozen = !passData->Frozen;
+				}
+
 			}
 			else if (items[index]->Type == ed::PipelineItem::ItemType::Geometry || items[index]->Type == ed::PipelineItem::ItemType::Model) {
 				if (ImGui::MenuItem("Change Variables")) {
@@ -459,6 +470,35 @@ namespace ed
 		return ret;
 	}
 
+	void PipelineUI::m_renderDependencies(ed::PipelineItem* item)
+	{
+		RenderGraph& graph = m_data->Renderer.GetGraph();
+		std::vector<PipelineItem*>& passes = m_data->Pipeline.GetList();
+
+		if (!graph.IsUsed(item))
+			ImGui::TextDisabled("Output is not used");
+
+		// the graph is built while rendering - skip the items that were removed since then
+		ImGui::Text("Reads from:");
+		int count = 0;
+		for (PipelineItem* input : graph.GetInputs(item))
+			if (std::count(passes.begin(), passes.end(), input)) {
+				ImGui::BulletText("%s", input->Name);
+				count++;
+			}
+		if (count == 0)
+			ImGui::TextDisabled("  nothing");
+
+		ImGui::Text("Read by:");
+		count = 0;
+		for (PipelineItem* output : graph.GetOutputs(item))
+			if (std::count(passes.begin(), passes.end(), output)) {
+				ImGui::BulletText("%s", output->Name);
+				count++;
+			}
+		if (count == 0)
+			ImGui::TextDisabled("  nothing");
+	}
 	void PipelineUI::m_closePopup()
 	{
 		ImGui::CloseCurrentPopup();
@@ -688,7 +728,8 @@ namespace ed
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0, 0, 0, 0));
 
 		int id = 0;
-		std::vector<ed::ShaderVariable *> &els = isCompute ? ((pipe::ComputePass*)itemData)->Variables.GetVariables() : (isAudio ? ((pipe::AudioPass*)itemData)->Variables.GetVariables() : ((pipe::ShaderPass*)itemData)->Variables.GetVariables());
+		ShaderVariableContainer& vars = isCompute ? ((pipe::ComputePass*)itemData)->Variables : (isAudio ? ((pipe::AudioPass*)itemData)->Variables : ((pipe::ShaderPass*)itemData)->Variables);
+		std::vector<ed::ShaderVariable *> &els = vars.GetVariables();
 
 		/* EXISTING VARIABLES */
 		for (auto& el : els) {
@@ -712,6 +753,7 @@ namespace ed
 				ed::ShaderVariable* temp = els[id - 1];
 				els[id - 1] = el;
 				els[id] = temp;
+				vars.Invalidate();
 
 				// then pin again if it was previously pinned
 				if (containsCur)
@@ -738,6 +780,7 @@ namespace ed
 				ed::ShaderVariable* temp = els[id + 1];
 				els[id + 1] = el;
 				els[id] = temp;
+				vars.Invalidate();
 
 				// then pin again if it was previously pinned
 				if (containsCur)
@@ -752,12 +795,7 @@ namespace ed
 				
 				m_data->Parser.ModifyProject();
 
-				if (isCompute)
-					((pipe::ComputePass*)itemData)->Variables.Remove(el->Name);
-				else if (isAudio)
-					((pipe::AudioPass*)itemData)->Variables.Remove(el->Name);
-				else
-					((pipe::ShaderPass*)itemData)->Variables.Remove(el->Name);
+				vars.Remove(el->Name);
 
 				ImGui::PopStyleColor();
 				continue;
@@ -796,13 +834,16 @@ namespace ed
 			ImGui::PushItemWidth(-ImGui::GetStyle().FramePadding.x);
 			ShaderVariable::ValueType tempType = el->GetType();
 			if (ImGui::Combo(("##inputType" + std::to_string(id)).c_str(), reinterpret_cast<int*>(&tempType), isGLSL ? VARIABLE_TYPE_NAMES_GLSL : VARIABLE_TYPE_NAMES, HARRAYSIZE(VARIABLE_TYPE_NAMES)))
-				if (tempType != el->GetType())
+				if (tempType != el->GetType()) {
 					el->SetType(tempType);
+					vars.Invalidate();
+				}
 			ImGui::NextColumn();
 
 			/* NAME */
 			ImGui::PushItemWidth(-ImGui::GetStyle().FramePadding.x);
 			if (ImGui::InputText(("##name" + std::to_string(id)).c_str(), const_cast<char*>(el->Name), VARIABLE_NAME_LENGTH)) {
+				vars.Invalidate();
 				m_data->Parser.ModifyProject();
 			}
 			ImGui::NextColumn();
@@ -818,6 +859,7 @@ namespace ed
 						if ((n == 0 || ed::SystemVariableManager::GetType((ed::SystemShaderVariable)n) == el->GetType())
 							&& ImGui::Selectable(SYSTEM_VARIABLE_NAMES[n], is_selected)) {
 							el->System = (ed::SystemShaderVariable)n;
+							vars.Invalidate();
 							m_data->Parser.ModifyProject();
 						}
 					} else {
@@ -825,6 +867,7 @@ namespace ed
 						if (modified) {
 							m_data->Parser.ModifyProject();
 							el->System = SystemShaderVariable::PluginVariable;
+							vars.Invalidate();
 						}
 					}
 					if (is_selected)
@@ -871,12 +914,7 @@ namespace ed
 
 			// add if it doesnt exist
 			if (!exists) {
-				if (isCompute)
-					((pipe::ComputePass *)itemData)->Variables.AddCopy(iVariable);
-				else if (isAudio)
-					((pipe::AudioPass *)itemData)->Variables.AddCopy(iVariable);
-				else
-					((pipe::ShaderPass *)itemData)->Variables.AddCopy(iVariable);
+				vars.AddCopy(iVariable);
 
 				iVariable = ShaderVariable(ShaderVariable::ValueType::Float1, "var", ed::SystemShaderVariable::None);
 				iValueType = ShaderVariable::ValueType::Float1;
@@ -981,7 +1019,7 @@ namespace ed
 				break;
 		}
 
-		std::vector<ShaderVariable*>& vars = ownerData->Variables.GetVariables();
+		const std::vector<ShaderVariable*>& vars = ownerData->Variables.GetVariables();
 		ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
 
 		// render the list
@@ -1394,11 +1432,13 @@ namespace ed
 		if (ewCount > 0)
 			ImGui::PushStyleColor(ImGuiCol_Text, ThemeContainer::Instance().GetTextEditorStyle(Settings::Instance().Theme)[(int)TextEditor::PaletteIndex::ErrorMessage]);
 		
-		if (!data->Active)
+		bool isSkipped = data->Active && Settings::Instance().Preview.SkipUnusedPasses && !m_data->Renderer.GetGraph().IsUsed(item);
+		if (!data->Active || isSkipped)
 			ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
 			
 		ImGui::Indent(PIPELINE_SHADER_PASS_INDENT);
-		if (ImGui::Selectable(item->Name, false, ImGuiSelectableFlags_AllowDoubleClick))
+		std::string label = data->Frozen ? (std::string(item->Name) + " " UI_ICON_LOCK "###" + std::string(item->Name)) : std::string(item->Name);
+		if (ImGui::Selectable(label.c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
 			if (ImGui::IsMouseDoubleClicked(0))
 			{
 				if (Settings::Instance().General.OpenShadersOnDblClk)
@@ -1425,6 +1465,10 @@ namespace ed
 					props->Open(item);
 				}
 			}
+		if (isSkipped)
+			m_tooltip("Nothing uses the output of this pass (window, other passes, preview windows) so it is skipped");
+		else if (data->Frozen)
+			m_tooltip("This pass is frozen - its last output is reused until it is unfrozen");
 
 		if (ImGui::BeginDragDropTarget()) {
 			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("PipelineItemPayload"))
@@ -1563,7 +1607,7 @@ namespace ed
 
 		ImGui::Unindent(PIPELINE_SHADER_PASS_INDENT);
 		
-		if (!data->Active)
+		if (!data->Active || isSkipped)
 			ImGui::PopStyleVar();
 			
 		if (ewCount > 0)
@@ -1579,8 +1623,13 @@ namespace ed
 		else
 			ImGui::PushStyleColor(ImGuiCol_Text, ThemeContainer::Instance().GetCustomStyle(Settings::Instance().Theme).ComputePass);
 
+		bool isSkipped = Settings::Instance().Preview.SkipUnusedPasses && !m_data->Renderer.GetGraph().IsUsed(item);
+		if (isSkipped)
+			ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
+
 		ImGui::Indent(PIPELINE_SHADER_PASS_INDENT);
-		if (ImGui::Selectable(item->Name, false, ImGuiSelectableFlags_AllowDoubleClick))
+		std::string label = data->Frozen ? (std::string(item->Name) + " " UI_ICON_LOCK "###" + std::string(item->Name)) : std::string(item->Name);
+		if (ImGui::Selectable(label.c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
 			if (ImGui::IsMouseDoubleClicked(0))
 			{
 				if (Settings::Instance().General.OpenShadersOnDblClk)
@@ -1601,7 +1650,14 @@ namespace ed
 					props->Open(item);
 				}
 			}
+		if (isSkipped)
+			m_tooltip("Nothing uses the output of this pass (window, other passes, preview windows) so it is skipped");
+		else if (data->Frozen)
+			m_tooltip("This pass is frozen - its last output is reused until it is unfrozen");
 		ImGui::Unindent(PIPELINE_SHADER_PASS_INDENT);
+
+		if (isSkipped)
+			ImGui::PopStyleVar();
 		ImGui::PopStyleColor();
 	}
 	void PipelineUI::m_addAudioPass(ed::PipelineItem *item)
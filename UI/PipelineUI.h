@@ -55,6 +55,7 @@ namespace ed
 		void m_renderResourceManagerUI();
 		void m_renderChangeVariablesUI();
 		void m_renderMacroManagerUI();
+		void m_renderDependencies(ed::PipelineItem* item);
 
 		void m_tooltip(const std::string& text);
 		void m_renderVarFlags(ed::ShaderVariable* var, char flags);
@@ -10,6 +10,7 @@
 #include "../Objects/ThemeContainer.h"
 #include "../Engine/GeometryFactory.h"
 #include "../Engine/GLUtils.h"
+#include "../Engine/GLCallCounter.h"
 
 #include <chrono>
 #include <thread>
@@ -789,6 +790,22 @@ namespace ed
 		else if (m_pickMode == 2) ImGui::PopStyleColor();
 		ImGui::SameLine();
 
+		// GL calls made in the last frame
+		gl::CallCounter& glCalls = gl::CallCounter::Instance();
+		if (glCalls.IsEnabled()) {
+			ImGui::SameLine(0, 20 * Settings::Instance().DPIScale);
+			ImGui::Text("Draws: %u  Binds: %u  Uniforms: %u", glCalls.Get(gl::CallCounter::Type::Draw) + glCalls.Get(gl::CallCounter::Type::Dispatch),
+				glCalls.Get(gl::CallCounter::Type::ProgramBind) + glCalls.Get(gl::CallCounter::Type::TextureBind) + glCalls.Get(gl::CallCounter::Type::BufferBind) + glCalls.Get(gl::CallCounter::Type::FramebufferBind),
+				glCalls.Get(gl::CallCounter::Type::UniformUpload));
+			if (ImGui::IsItemHovered()) {
+				ImGui::BeginTooltip();
+				for (int i = 0; i < (int)gl::CallCounter::Type::Count; i++)
+					ImGui::Text("%s: %u", gl::CallCounter::GetName((gl::CallCounter::Type)i), glCalls.Get((gl::CallCounter::Type)i));
+				ImGui::EndTooltip();
+			}
+			ImGui::SameLine();
+		}
+
 		if (m_picks.size() != 0) {
 			ImGui::SameLine(0, 20*Settings::Instance().DPIScale);
 			ImGui::Text("Picked: ");
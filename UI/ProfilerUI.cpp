@@ -0,0 +1,150 @@
+#include "ProfilerUI.h"
+#include "../Objects/ThemeContainer.h"
+#include "../Objects/Settings.h"
+#include <imgui/imgui.h>
+#include <float.h>
+
+#define PLOT_HEIGHT 60 * Settings::Instance().DPIScale
+
+namespace ed
+{
+	void ProfilerUI::OnEvent(const SDL_Event& e)
+	{}
+	void ProfilerUI::Update(float delta)
+	{
+		PipelineProfiler& profiler = m_data->Renderer.GetProfiler();
+		const PipelineProfiler::History& frame = profiler.GetFrameHistory();
+		ed::CustomColors clrs = ThemeContainer::Instance().GetCustomStyle(Settings::Instance().Theme);
+
+		ImGui::Checkbox("Pause##prof_pause", &m_paused);
+		ImGui::SameLine();
+		if (ImGui::Button("Reset##prof_reset"))
+			profiler.Reset();
+		ImGui::SameLine();
+		ImGui::Text("CPU: %.3fms (peak %.3fms)   GPU: %.3fms (peak %.3fms)", frame.GetAverage(frame.CPU), frame.GetMax(frame.CPU), frame.GetAverage(frame.GPU), frame.GetMax(frame.GPU));
+
+		// frame timeline
+		if (frame.Size() > 0) {
+			ImGui::PushItemWidth(-1);
+			ImGui::PlotLines("##prof_frame_gpu", frame.GPU.data(), frame.Size(), frame.Next, "GPU", 0.0f, FLT_MAX, ImVec2(0, PLOT_HEIGHT));
+			ImGui::PlotLines("##prof_frame_cpu", frame.CPU.data(), frame.Size(), frame.Next, "CPU", 0.0f, FLT_MAX, ImVec2(0, PLOT_HEIGHT));
+			ImGui::PopItemWidth();
+		}
+
+		ImGui::Separator();
+
+		// find the most expensive pass and the most expensive item inside of a pass
+		auto getCost = [&](PipelineItem* item) -> float {
+			const PipelineProfiler::History* hist = profiler.GetHistory(item);
+			if (hist == nullptr)
+				return 0.0f;
+			return std::max(hist->GetAverage(hist->GPU), hist->GetAverage(hist->CPU));
+		};
+
+		std::vector<PipelineItem*>& passes = m_data->Pipeline.GetList();
+		PipelineItem* expensivePass = nullptr;
+		PipelineItem* expensiveItem = nullptr;
+		float passCost = 0.0f, itemCost = 0.0f;
+		for (PipelineItem* pass : passes) {
+			float cost = getCost(pass);
+			if (cost > passCost) {
+				passCost = cost;
+				expensivePass = pass;
+			}
+
+			if (pass->Type == PipelineItem::ItemType::ShaderPass) {
+				pipe::ShaderPass* data = (pipe::ShaderPass*)pass->Data;
+				for (PipelineItem* item : data->Items) {
+					cost = getCost(item);
+					if (cost > itemCost) {
+						itemCost = cost;
+						expensiveItem = item;
+					}
+				}
+			}
+		}
+
+		ImGui::BeginChild("##prof_table", ImVec2(-1, -1));
+
+		ImGui::Columns(8, "##prof_columns");
+		ImGui::Text("Item"); ImGui::NextColumn();
+		ImGui::Text("CPU"); ImGui::NextColumn();
+		ImGui::Text("Bind"); ImGui::NextColumn();
+		ImGui::Text("Uniforms"); ImGui::NextColumn();
+		ImGui::Text("Draw"); ImGui::NextColumn();
+		ImGui::Text("GPU"); ImGui::NextColumn();
+		ImGui::Text("GPU peak"); ImGui::NextColumn();
+		ImGui::Text("GPU history"); ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (PipelineItem* pass : passes) {
+			std::vector<PipelineItem*>* children = nullptr;
+			if (pass->Type == PipelineItem::ItemType::ShaderPass && ((pipe::ShaderPass*)pass->Data)->Items.size() > 0)
+				children = &((pipe::ShaderPass*)pass->Data)->Items;
+
+			ImGui::PushID(pass);
+
+			if (pass == expensivePass)
+				ImGui::PushStyleColor(ImGuiCol_Text, clrs.WarningMessage);
+
+			bool isOpen = false;
+			if (children != nullptr)
+				isOpen = ImGui::TreeNode(pass->Name);
+			else
+				ImGui::TreeNodeEx(pass->Name, ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen);
+			ImGui::NextColumn();
+
+			m_renderColumns(pass);
+
+			if (pass == expensivePass)
+				ImGui::PopStyleColor();
+
+			if (isOpen) {
+				for (PipelineItem* item : *children) {
+					if (item == expensiveItem)
+						ImGui::PushStyleColor(ImGuiCol_Text, clrs.WarningMessage);
+
+					ImGui::TreeNodeEx(item, ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen, "%s", item->Name);
+					ImGui::NextColumn();
+
+					m_renderColumns(item);
+
+					if (item == expensiveItem)
+						ImGui::PopStyleColor();
+				}
+				ImGui::TreePop();
+			}
+
+			ImGui::PopID();
+		}
+
+		ImGui::Columns(1);
+		ImGui::EndChild();
+	}
+	void ProfilerUI::m_renderColumns(PipelineItem* item)
+	{
+		const PipelineProfiler::History* hist = m_data->Renderer.GetProfiler().GetHistory(item);
+		if (hist == nullptr || hist->Size() == 0) {
+			for (int i = 0; i < 7; i++) {
+				ImGui::Text("-");
+				ImGui::NextColumn();
+			}
+			return;
+		}
+
+		ImGui::Text("%.3fms", hist->GetAverage(hist->CPU)); ImGui::NextColumn();
+		for (int i = 0; i < (int)PipelineProfiler::Category::Count; i++) {
+			ImGui::Text("%.3fms", hist->GetAverage(hist->Breakdown[i]));
+			ImGui::NextColumn();
+		}
+		ImGui::Text("%.3fms", hist->GetAverage(hist->GPU)); ImGui::NextColumn();
+		ImGui::Text("%.3fms", hist->GetMax(hist->GPU)); ImGui::NextColumn();
+
+		ImGui::PushID(item);
+		ImGui::PushItemWidth(-1);
+		ImGui::PlotLines("##prof_item_gpu", hist->GPU.data(), hist->Size(), hist->Next, nullptr, 0.0f, FLT_MAX, ImVec2(0, ImGui::GetTextLineHeight()));
+		ImGui::PopItemWidth();
+		ImGui::PopID();
+		ImGui::NextColumn();
+	}
+}
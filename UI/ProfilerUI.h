@@ -0,0 +1,24 @@
+#pragma once
+#include "UIView.h"
+
+namespace ed
+{
+	class ProfilerUI : public UIView
+	{
+	public:
+		ProfilerUI(GUIManager* ui, ed::InterfaceManager* objects, const std::string& name = "", bool visible = false) :
+			UIView(ui, objects, name, visible) {
+			m_paused = false;
+		}
+
+		virtual void OnEvent(const SDL_Event& e);
+		virtual void Update(float delta);
+
+		inline bool IsPaused() { return m_paused; }
+
+	private:
+		void m_renderColumns(PipelineItem* item); // everything except the name
+
+		bool m_paused;
+	};
+}
@@ -22,6 +22,44 @@ namespace ed
 		m_currentObj = nullptr;
 		memset(m_itemName, 0, 64 * sizeof(char));
 	}
+	void PropertyUI::m_renderPassRate(int& runEvery, float& maxRate, int& slices)
+	{
+		ImGui::Separator();
+
+		/* run every N frames */
+		ImGui::Text("Run every N frames:");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		if (ImGui::InputInt("##pui_runevery", &runEvery)) {
+			runEvery = std::max(runEvery, 1);
+			m_data->Parser.ModifyProject();
+		}
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+		ImGui::Separator();
+
+		/* max executions per second */
+		ImGui::Text("Max rate (Hz):");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		if (ImGui::DragFloat("##pui_maxrate", &maxRate, 0.1f, 0.0f, 1000.0f, maxRate <= 0.0f ? "no limit" : "%.1f")) {
+			maxRate = std::max(maxRate, 0.0f);
+			m_data->Parser.ModifyProject();
+		}
+		ImGui::PopItemWidth();
+		ImGui::NextColumn();
+		ImGui::Separator();
+
+		/* time slices */
+		ImGui::Text("Time slices:");
+		ImGui::NextColumn();
+		ImGui::PushItemWidth(-1);
+		if (ImGui::InputInt("##pui_slices", &slices)) {
+			slices = std::max(slices, 1);
+			m_data->Parser.ModifyProject();
+		}
+		ImGui::PopItemWidth();
+	}
 	void PropertyUI::OnEvent(const SDL_Event& e)
 	{}
 	void PropertyUI::Update(float delta)
@@ -88,8 +126,7 @@ namespace ed
 						}
 
 						m_data->Messages.RenameGroup(m_current->Name, m_itemName);
-						memcpy(m_current->Name, m_itemName, PIPELINE_ITEM_NAME_LENGTH);
-						m_data->Parser.ModifyProject();
+						m_data->Pipeline.Rename(m_current, m_itemName);
 					}
 				}
 				ImGui::NextColumn();
@@ -343,6 +380,8 @@ namespace ed
 					ImGui::NextColumn();
 
 					if (!item->GSUsed) ImGui::PopItemFlag();
+
+					m_renderPassRate(item->RunEvery, item->MaxRate, item->Slices);
 				}
 				else if (m_current->Type == ed::PipelineItem::ItemType::ComputePass)
 				{
@@ -411,6 +450,9 @@ namespace ed
 
 						m_data->Parser.ModifyProject();
 					}
+					ImGui::NextColumn();
+
+					m_renderPassRate(item->RunEvery, item->MaxRate, item->Slices);
 				}
 				else if (m_current->Type == ed::PipelineItem::ItemType::AudioPass)
 				{
@@ -1103,6 +1145,25 @@ namespace ed
 					m_data->Parser.ModifyProject();
 				ImGui::NextColumn();
 				ImGui::Separator();
+
+				/* TRANSIENT? */
+				ImGui::Text("Transient:");
+				ImGui::NextColumn();
+				ImGui::PushItemWidth(-1);
+				if (ImGui::Checkbox("##pui_rttransient", &m_currentRT->Transient)) {
+					glm::ivec2 wsize(m_data->Renderer.GetLastRenderSize().x, m_data->Renderer.GetLastRenderSize().y);
+					m_data->Objects.ResizeRenderTexture(std::string(m_itemName), m_currentRT->CalculateSize(wsize.x, wsize.y));
+					m_data->Parser.ModifyProject();
+				}
+				if (ImGui::IsItemHovered()) {
+					ImGui::BeginTooltip();
+					ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+					ImGui::TextUnformatted("Share the depth & multisampled buffers with the other transient render textures that are rendered to in a different part of the frame");
+					ImGui::PopTextWrapPos();
+					ImGui::EndTooltip();
+				}
+				ImGui::NextColumn();
+				ImGui::Separator();
 		
 
 				/* CLEAR COLOR */
@@ -29,6 +29,7 @@ namespace ed
 		char m_itemName[64];
 
 		void m_init();
+		void m_renderPassRate(int& runEvery, float& maxRate, int& slices); // "Run every", "Max rate" & "Slices" rows
 
 		PipelineItem* m_current;
 		ObjectManagerItem* m_currentObj;
@@ -29,6 +29,7 @@ namespace ed
 			ImGui::SetCursorPosX(ImGui::GetWindowWidth()-(71+ImGui::GetStyle().WindowPadding.x*2));
 			if (ImGui::Button((UI_ICON_EDIT "##" + std::string(m_var->Name)).c_str(), ImVec2(25, 0))) {
 				m_var->Function = FunctionShaderVariable::None;
+				FunctionVariableManager::Invalidate();
 				modified = true;
 			}
 
@@ -185,6 +186,7 @@ namespace ed
 						m_var->Function = FunctionShaderVariable::PluginFunction;
 						m_var->Arguments = (char*)malloc(m_var->PluginFuncData.Owner->GetVariableFunctionArgSpaceSize(m_var->PluginFuncData.Name, (plugin::VariableType)m_var->GetType()));
 						m_var->PluginFuncData.Owner->InitVariableFunctionArguments(m_var->Arguments, m_var->PluginFuncData.Name, (plugin::VariableType)m_var->GetType());
+						FunctionVariableManager::Invalidate();
 					}
 				}
 				if (is_selected)
@@ -218,6 +220,7 @@ namespace ed
 						bool is_selected = strcmp(m_var->Arguments, varList[n]->Name) == 0;
 						if (ImGui::Selectable(varList[n]->Name, is_selected)) {
 							strcpy(m_var->Arguments, varList[n]->Name);
+							FunctionVariableManager::Invalidate();
 							ret = true;
 						}
 						if (is_selected)
@@ -7,7 +7,11 @@
 #include "Objects/AudioShaderStream.h"
 #include "Objects/Settings.h"
 #include "Objects/Logger.h"
+#include "Objects/CommandLineOptionParser.h"
+#include "Objects/Tracer.h"
+#include "Objects/StartupProfiler.h"
 #include "EditorEngine.h"
+#include "HeadlessEngine.h"
 #include "Engine/GeometryFactory.h"
 
 #include <thread>
@@ -70,12 +74,23 @@ void setIcon(SDL_Window* wnd)
 
 	stbi_set_flip_vertically_on_load(1);
 }
+void saveTrace(const ed::CommandLineOptionParser& opts)
+{
+	// tracing might have been stopped through the menu
+	if (opts.TraceFile.empty() || !ed::Tracer::Instance().IsEnabled())
+		return;
+
+	ed::Tracer::Instance().Stop();
+	ed::Tracer::Instance().Save(opts.TraceFile);
+}
 
 #include <stdio.h>
 #include <string.h>
 
 int main(int argc, char* argv[])
 {
+	ed::StartupProfiler& startup = ed::StartupProfiler::Instance(); // starts the clock
+
 	ghc::filesystem::path cmdDir = ghc::filesystem::current_path();
 	if (argc > 0) {
 		if (ghc::filesystem::exists(ghc::filesystem::path(argv[0]).parent_path())) {
@@ -85,10 +100,19 @@ int main(int argc, char* argv[])
 		}
 	}
 
+	// paths passed through arguments are resolved relative to cmdDir
+	ed::CommandLineOptionParser coptsParser;
+	if (argc > 1)
+		coptsParser.Parse(cmdDir, argc - 1, argv + 1);
+	startup.SetEnabled(coptsParser.ProfileStartup && coptsParser.LaunchUI);
+
+	if (!coptsParser.TraceFile.empty()) {
+		ed::Tracer::Instance().SetThreadName("Main");
+		ed::Tracer::Instance().Start();
+	}
+
 #if defined(__linux__) || defined(__unix__)
-	// currently the only supported argument is a path to set the working directory... dont do this check if user wants to explicitly set the working directory,
-	// TODO: if more arguments get added, use different methods to check if working directory is being set explicitly
-	if (argc <= 1) { 
+	{
 		char result[PATH_MAX];
 		ssize_t readlinkRes = readlink("/proc/self/exe", result, PATH_MAX);
 		std::string exePath = "";
@@ -126,6 +150,7 @@ int main(int argc, char* argv[])
 	stbi_set_flip_vertically_on_load(1);
 
 	// start glslang process
+	startup.Begin("Initializing glslang");
 	bool glslangInit = glslang::InitializeProcess();
 	ed::Logger::Get().Log("Initializing glslang...");
 
@@ -133,15 +158,41 @@ int main(int argc, char* argv[])
 		ed::Logger::Get().Log("Finished glslang initialization");
 	else
 		ed::Logger::Get().Log("Failed to initialize glslang", true);
+	startup.End();
 
+	// render the project without opening a window
+	if (coptsParser.Headless || coptsParser.Benchmark || coptsParser.Compile || coptsParser.Regression || coptsParser.Microbench) {
+		int exitCode = 0;
+		{
+			ed::HeadlessEngine headless;
+			if (coptsParser.Compile)
+				exitCode = headless.Compile(coptsParser);
+			else if (coptsParser.Microbench)
+				exitCode = headless.Microbench(coptsParser);
+			else if (coptsParser.Regression)
+				exitCode = headless.Regression(coptsParser);
+			else if (coptsParser.Benchmark)
+				exitCode = headless.Benchmark(coptsParser);
+			else
+				exitCode = headless.Run(coptsParser);
+		}
+		glslang::FinalizeProcess();
+		saveTrace(coptsParser);
+		ed::Logger::Get().Save();
+		return exitCode;
+	}
+	if (!coptsParser.LaunchUI)
+		return 0;
 	
 	// init sdl2
+	startup.Begin("Initializing SDL2");
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO) < 0) {
 		ed::Logger::Get().Log("Failed to initialize SDL2", true);
 		ed::Logger::Get().Save();
 		return 0;
 	} else
 		ed::Logger::Get().Log("Initialized SDL2");
+	startup.End();
 
 	// load window size
 	short wndWidth = 800, wndHeight = 600, wndPosX = -1, wndPosY = -1;
@@ -183,6 +234,7 @@ int main(int argc, char* argv[])
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1); // double buffering
 
 	// open window
+	startup.Begin("Creating the window and GL context");
 	SDL_Window* wnd = SDL_CreateWindow("SHADERed", wndPosX == -1 ? SDL_WINDOWPOS_CENTERED : wndPosX, wndPosY == -1 ? SDL_WINDOWPOS_CENTERED : wndPosY, wndWidth, wndHeight, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
 	SDL_SetWindowMinimumSize(wnd, 200, 200);
 
@@ -208,22 +260,24 @@ int main(int argc, char* argv[])
 		return 0;
 	} else
 		ed::Logger::Get().Log("Initialized GLEW");
+	startup.End();
 
 	// create engine
+	startup.Begin("Constructing EditorEngine");
 	ed::EditorEngine engine(wnd, &glContext);
+	startup.End();
 	ed::Logger::Get().Log("Creating EditorEngine...");
+	startup.Begin("EditorEngine::Create");
 	engine.Create();
+	startup.End();
 	ed::Logger::Get().Log("Created EditorEngine");
 
 	// open an item if given in arguments
-	if (argc >= 2) {
-		ed::Logger::Get().Log("Openning a file provided through argument " + std::string(argv[1]));
-		engine.UI().Open(argv[1]);
-		ghc::filesystem::path argFile = cmdDir / ghc::filesystem::path(argv[1]);
-		if (ghc::filesystem::exists(argv[1]))
-			engine.UI().Open(argv[1]);
-		else if (ghc::filesystem::exists(argFile))
-			engine.UI().Open(argFile.c_str());
+	if (!coptsParser.ProjectFile.empty() && ghc::filesystem::exists(coptsParser.ProjectFile)) {
+		ed::Logger::Get().Log("Openning a file provided through argument " + coptsParser.ProjectFile);
+		startup.Begin("Opening " + coptsParser.ProjectFile);
+		engine.UI().Open(coptsParser.ProjectFile);
+		startup.End();
 	}
 
 	engine.UI().SetPerformanceMode(perfMode);
@@ -235,7 +289,13 @@ int main(int argc, char* argv[])
 	bool run = true;
 	bool minimized = false;
 	bool hasFocus = true;
+	bool firstFrame = true;
 	while (run) {
+		TRACE_ZONE("Frame");
+
+		if (firstFrame)
+			startup.Begin("First frame");
+
 		while (SDL_PollEvent(&event))
 		{
 			if (event.type == SDL_QUIT) {
@@ -278,7 +338,10 @@ int main(int argc, char* argv[])
 				else if (event.window.event == SDL_WINDOWEVENT_FOCUS_GAINED)
 					hasFocus = true;
 			}
-			engine.OnEvent(event);
+			{
+				TRACE_ZONE("OnEvent");
+				engine.OnEvent(event);
+			}
 		}
 
 		if (!run) break;
@@ -292,12 +355,24 @@ int main(int argc, char* argv[])
 
 		engine.Render();
 
-		SDL_GL_SwapWindow(wnd);
+		{
+			TRACE_ZONE("SwapWindow");
+			SDL_GL_SwapWindow(wnd);
+		}
 
-		if (minimized && delta * 1000 < 33)
+		if (firstFrame) {
+			startup.End();
+			startup.FirstFrame();
+			firstFrame = false;
+		}
+
+		if (minimized && delta * 1000 < 33) {
+			TRACE_ZONE("Sleep");
 			std::this_thread::sleep_for(std::chrono::milliseconds(33 - (int)(delta * 1000)));
-		else if (!hasFocus && ed::Settings::Instance().Preview.LostFocusLimitFPS && delta * 1000 < 16)
+		} else if (!hasFocus && ed::Settings::Instance().Preview.LostFocusLimitFPS && delta * 1000 < 16) {
+			TRACE_ZONE("Sleep");
 			std::this_thread::sleep_for(std::chrono::milliseconds(16 - (int)(delta * 1000)));
+		}
 	}
 
 	// union for converting short to bytes
@@ -337,6 +412,7 @@ int main(int argc, char* argv[])
 
 	ed::Logger::Get().Log("Destroyed EditorEngine and SDL2");
 
+	saveTrace(coptsParser);
 	ed::Logger::Get().Save();
 
 	return 0;